@@ -1,8 +1,9 @@
 /**
  * @file BST.h
- * @brief Definicja klasy BST (Binary Search Tree).
- * * Plik ten zawiera deklaracje klasy BST, w tym jej wewnetrzna strukture Node
+ * @brief Definicja szablonu BasicBST (Binary Search Tree) i typu BST dla kluczy int.
+ * * Plik ten zawiera deklaracje szablonu BasicBST, w tym jego wewnetrzna strukture Node
  * oraz wszystkie metody do zarzadzania drzewem (dodawanie, usuwanie, wyszukiwanie, wyswietlanie).
+ * Implementacja znajduje sie w BST.tpp.
  */
 
 #pragma once
@@ -12,101 +13,432 @@
 #include <string>
 #include <fstream>
 #include <iomanip> // Do printGraphical
+#include <functional> // Do less
+#include <memory> // Do allocator, allocator_traits
+#include <type_traits>
+#include <iterator> // Do bidirectional_iterator_tag
+
+#include "FrozenBST.h"
+#include "KeyCodec.h"
+#include "NodePool.h"
+#include "Stats.h"
+#include "ValueCodec.h"
 
 using namespace std;
 
  // Uzywamy forward-declaration, aby uniknac cyklicznych zaleznosci
-class FileHandler;
+template <typename Key, typename Compare, typename Allocator, typename Value>
+class BasicFileHandler;
+
+/**
+ * @brief Wartosc przechowywana w wezle drzewa (klasa bazowa wezla).
+ * @tparam Value Typ wartosci (moze byc tylko przenoszalny, np. unique_ptr).
+ */
+template <typename Value>
+struct NodeValue {
+    Value value; ///< Wartosc przypisana do klucza.
+
+    /**
+     * @brief Tworzy wartosc w miejscu z podanych argumentow.
+     * @param args Argumenty konstruktora wartosci.
+     */
+    template <typename... Args>
+    explicit NodeValue(Args&&... args) : value(forward<Args>(args)...) {}
+
+    /// @brief Zwraca wskaznik na wartosc.
+    Value* get() { return &value; }
+
+    /// @brief Zwraca wskaznik na wartosc (wersja stala).
+    const Value* get() const { return &value; }
+};
 
 /**
- * @brief Implementacja drzewa binarnego poszukiwan (BST).
+ * @brief Specjalizacja dla drzewa bez wartosci - pusta baza nie zajmuje miejsca w wezle.
+ */
+template <>
+struct NodeValue<NoValue> : NoValue {
+    NodeValue() {}
+
+    /// @brief Pozwala budowac wezel z pary (klucz, NoValue), jak w trybie slownika.
+    explicit NodeValue(const NoValue&) {}
+
+    /// @brief Zwraca wskaznik na (pusta) wartosc.
+    NoValue* get() { return this; }
+
+    /// @brief Zwraca wskaznik na (pusta) wartosc (wersja stala).
+    const NoValue* get() const { return this; }
+};
+
+/**
+ * @brief Sposob wykonania operacji wsadowej (BasicBST::insertBatch, BasicBST::removeBatch).
+ */
+enum class BatchMode {
+    Auto, ///< Wybor na podstawie rozmiaru wsadu i drzewa.
+    Incremental, ///< Pojedyncze operacje w kolejnosci rosnacej - O(k log n).
+    Rebuild ///< Scalenie z zawartoscia drzewa i przebudowa - O(n + k).
+};
+
+/**
+ * @brief Implementacja drzewa binarnego poszukiwan (BST) dla dowolnego typu klucza.
  * * Klasa przechowuje elementy w uporzadkowanej strukturze drzewa,
  * umozliwiajac szybkie wyszukiwanie, dodawanie i usuwanie elementow.
+ * Klucze rownowazne w sensie Compare sa traktowane jak duplikaty.
+ * Z typem Value innym niz NoValue drzewo dziala jak slownik: kazdy wezel przechowuje
+ * tez wartosc przypisana do klucza.
+ * @tparam Key Typ klucza.
+ * @tparam Compare Porzadek kluczy (domyslnie less<Key>).
+ * @tparam Allocator Alokator, z ktorego pula wezlow pobiera pamiec slabow.
+ * @tparam Value Typ wartosci (domyslnie NoValue - drzewo bez wartosci).
  */
-class BST {
+template <typename Key = int, typename Compare = less<Key>, typename Allocator = allocator<Key>, typename Value = NoValue>
+class BasicBST {
 private:
+    /**
+     * @brief Sposob przekazywania klucza do metod.
+     * * Male, trywialnie kopiowalne klucze (np. int, long long) przekazujemy przez wartosc,
+     * pozostale przez stala referencje - wybor zapada w czasie kompilacji.
+     */
+    typedef typename conditional<is_trivially_copyable<Key>::value && sizeof(Key) <= 2 * sizeof(void*),
+        Key, const Key&>::type KeyArg;
+
+    /// @brief Czy porzadek to zwykle < na typie arytmetycznym (wtedy rownowaznosc to ==).
+    typedef integral_constant<bool, is_arithmetic<Key>::value && is_same<Compare, less<Key>>::value> NaturalOrder;
+
+    /// @brief Kodek kluczy uzywany przy zapisie i odczycie plikow.
+    typedef KeyCodec<Key, Compare> Codec;
+
+    /// @brief Czy wezly przechowuja wartosci (tryb slownika).
+    typedef integral_constant<bool, !is_same<Value, NoValue>::value> HasValue;
+
+    /// @brief Alokator slabow (Allocator przestawiony na bajty).
+    typedef typename allocator_traits<Allocator>::template rebind_alloc<char> SlabAllocator;
+
+    /// @brief Najmniejszy fragment danych, dla ktorego oplaca sie osobny watek.
+    static const size_t minParallelRange = 1 << 14;
+
+    /**
+     * @brief Stosunek kosztu przebudowy (na element drzewa) do kosztu pojedynczej operacji
+     * (na poziom drzewa), wyznaczony pomiarem w programie Benchmark.
+     */
+    static const size_t batchRebuildCost = 4;
+
     /**
      * @brief Struktura reprezentujaca pojedynczy wezel w drzewie BST.
+     * * Wartosc (tryb slownika) jest klasa bazowa, wiec drzewo bez wartosci ma wezly tej samej wielkosci.
+     * Wysokosc stoi zaraz za kluczem, aby dla kluczy int wypelnic wyrownanie przed wskaznikami.
      */
-    struct Node {
-        int data; ///< Wartosc przechowywana w wezle.
+    struct Node : NodeValue<Value> {
+        Key data; ///< Wartosc przechowywana w wezle.
+        int height; ///< Wysokosc poddrzewa zakorzenionego w tym wezle (lisc ma wysokosc 1).
         Node* left; ///< Wskaznik na lewe dziecko.
         Node* right; ///< Wskaznik na prawe dziecko.
+        Node* parent; ///< Wskaznik na rodzica (nullptr dla korzenia) - pozwala iterowac bez stosu.
+        size_t size; ///< Liczba wezlow poddrzewa zakorzenionego w tym wezle (lisc ma rozmiar 1).
 
         /**
          * @brief Konstruktor wezla.
          * @param val Wartosc do przechowania w wezle.
+         * @param args Argumenty konstruktora wartosci (w trybie slownika).
          */
-        Node(int val) : data(val), left(nullptr), right(nullptr) {}
+        template <typename... Args>
+        explicit Node(KeyArg val, Args&&... args)
+            : NodeValue<Value>(forward<Args>(args)...), data(val), height(1), left(nullptr), right(nullptr), parent(nullptr), size(1) {}
     };
 
     /// @brief Wskaznik na korzen drzewa.
     Node* root;
 
-    // --- Metody pomocnicze (rekurencyjne) ---
+    /// @brief Liczba wezlow w drzewie.
+    size_t nodeCount;
+
+    /// @brief Czy drzewo jest samowywazajace (AVL). Jesli false, zachowuje sie jak zwykle BST.
+    bool balanced;
+
+    /// @brief Porzadek kluczy.
+    Compare comp;
+
+    /// @brief Pula pamieci, z ktorej pochodza wszystkie wezly drzewa.
+    NodePool<SlabAllocator> pool;
+
+    /// @brief Liczniki statystyk (puste, jesli BST_STATS nie jest wlaczone); zmieniaja je tez wyszukiwania.
+    mutable TreeCounters<statsEnabled> counters;
 
     /**
-     * @brief Prywatna, rekurencyjna metoda do wstawiania nowego wezla.
-     * @param node Aktualnie przetwarzany wezel.
-     * @param data Wartosc do wstawienia.
-     * @return Wskaznik na (potencjalnie nowy) korzen poddrzewa.
+     * @brief Tworzy nowy wezel w pamieci z puli.
+     * @param data Wartosc do przechowania w wezle.
+     * @param args Argumenty konstruktora wartosci (w trybie slownika).
+     * @return Wskaznik na nowy wezel.
      */
-    Node* insert(Node* node, int data);
+    template <typename... Args>
+    Node* createNode(KeyArg data, Args&&... args);
 
     /**
-     * @brief Prywatna, rekurencyjna metoda do usuwania wezla.
-     * @param node Aktualnie przetwarzany wezel.
-     * @param data Wartosc do usuniecia.
-     * @return Wskaznik na korzen poddrzewa po usunieciu.
+     * @brief Zwraca pamiec wezla do puli.
+     * @param node Wezel do zniszczenia.
+     */
+    void destroyNode(Node* node);
+
+    /**
+     * @brief Wywoluje destruktory kluczy i wartosci wszystkich wezlow (przed zwolnieniem pamieci puli).
+     * * Dla wezlow trywialnie zniszczalnych nic nie robi.
+     */
+    void destroyKeys();
+
+    /**
+     * @brief Jeden krok wyszukiwania: porownuje szukany klucz z kluczem wezla.
+     * @param data Szukany klucz.
+     * @param nodeKey Klucz wezla.
+     * @param goLeft Ustawiane na true, jesli szukany klucz jest mniejszy (trzeba isc w lewo).
+     * @return true jesli klucze sa rownowazne.
+     */
+    bool matches(KeyArg data, KeyArg nodeKey, bool& goLeft) const {
+        return matches(data, nodeKey, goLeft, NaturalOrder());
+    }
+
+    /// @brief Wersja dla typow arytmetycznych i less<Key>: == i <, jak w drzewie int (wybor dziecka przez cmov).
+    bool matches(KeyArg data, KeyArg nodeKey, bool& goLeft, true_type) const {
+        goLeft = data < nodeKey;
+        return data == nodeKey;
+    }
+
+    /// @brief Wersja ogolna: dwa wywolania Compare.
+    bool matches(KeyArg data, KeyArg nodeKey, bool& goLeft, false_type) const {
+        goLeft = comp(data, nodeKey);
+        return !goLeft && !comp(nodeKey, data);
+    }
+
+    // --- Metody pomocnicze do rownowazenia (AVL) ---
+
+    /**
+     * @brief Zwraca wysokosc poddrzewa (0 dla pustego poddrzewa).
+     * @param node Korzen poddrzewa.
+     * @return Wysokosc poddrzewa.
+     */
+    static int height(Node* node);
+
+    /**
+     * @brief Zwraca liczbe wezlow poddrzewa (0 dla pustego poddrzewa).
+     * @param node Korzen poddrzewa.
+     * @return Rozmiar poddrzewa.
+     */
+    static size_t subtreeSize(Node* node);
+
+    /**
+     * @brief Przelicza wysokosc i rozmiar wezla na podstawie jego dzieci.
+     * @param node Wezel do aktualizacji (nie moze byc nullptr).
+     */
+    static void updateNode(Node* node);
+
+    /**
+     * @brief Zwraca skrajnie lewy (najmniejszy) wezel poddrzewa.
+     * @param node Korzen poddrzewa (nie moze byc nullptr).
+     * @return Najmniejszy wezel.
+     */
+    static Node* leftmost(Node* node);
+
+    /**
+     * @brief Zwraca skrajnie prawy (najwiekszy) wezel poddrzewa.
+     * @param node Korzen poddrzewa (nie moze byc nullptr).
+     * @return Najwiekszy wezel.
+     */
+    static Node* rightmost(Node* node);
+
+    /**
+     * @brief Wykonuje rotacje w lewo wokol podanego wezla.
+     * @param node Korzen poddrzewa (musi miec prawe dziecko).
+     * @return Nowy korzen poddrzewa.
+     */
+    static Node* rotateLeft(Node* node);
+
+    /**
+     * @brief Wykonuje rotacje w prawo wokol podanego wezla.
+     * @param node Korzen poddrzewa (musi miec lewe dziecko).
+     * @return Nowy korzen poddrzewa.
+     */
+    static Node* rotateRight(Node* node);
+
+    /**
+     * @brief Aktualizuje wysokosc wezla i, w trybie zrownowazonym, przywraca warunek AVL.
+     * @param node Korzen poddrzewa, ktorego dzieci sa juz zrownowazone.
+     * @return Nowy korzen poddrzewa.
+     */
+    Node* rebalance(Node* node);
+
+    // --- Metody pomocnicze (iteracyjne) ---
+    // Wszystkie operacje korzystaja z jawnych stosow na stercie zamiast rekurencji,
+    // wiec nawet zdegenerowane drzewo (np. bez rownowazenia) nie przepelni stosu wywolan.
+
+    /**
+     * @brief Bufor roboczy na sciezke od korzenia (adresy wskaznikow prowadzacych do kolejnych wezlow).
+     * * Jest wspoldzielony przez insert/remove, aby po rozgrzaniu nie alokowac pamieci przy kazdej operacji.
+     */
+    vector<Node**> path;
+
+    /**
+     * @brief Przywraca wysokosci i warunek AVL na sciezce zapisanej w buforze path (od dolu do gory).
+     * * Konczy sie wczesniej, gdy wysokosc poddrzewa nie ulegla zmianie - wyzsze poziomy sa wtedy juz poprawne.
+     * Rozmiary poddrzew na sciezce trzeba wczesniej poprawic metoda resize().
+     * @param depth Liczba poczatkowych wpisow bufora path do przetworzenia.
+     */
+    void retrace(size_t depth);
+
+    /**
+     * @brief Zmienia rozmiary wszystkich poddrzew na sciezce zapisanej w buforze path.
+     * @param delta +1 po dodaniu wezla, -1 po usunieciu.
+     */
+    void resize(ptrdiff_t delta);
+
+    /**
+     * @brief Sprawdza, czy wsad o podanym rozmiarze taniej wykonac przebudowa drzewa.
+     * * Pojedyncze operacje kosztuja okolo k * log2(n + k), przebudowa okolo n + k
+     * (z wieksza stala - patrz batchRebuildCost).
+     * @param batch Liczba kluczy we wsadzie.
+     * @param mode Wybrany sposob wykonania.
+     * @return true jesli wsad nalezy wykonac przebudowa.
+     */
+    bool preferRebuild(size_t batch, BatchMode mode) const;
+
+    /**
+     * @brief Liczy klucze mniejsze od podanego (lub mniejsze albo rownowazne).
+     * @param data Klucz odniesienia.
+     * @param inclusive Czy liczyc takze klucz rownowazny data.
+     * @return Liczba kluczy.
+     */
+    size_t countBelow(KeyArg data, bool inclusive) const;
+
+    /**
+     * @brief Dopisuje wartosci poddrzewa (w kolejnosci Inorder, czyli posortowane) na koniec wektora.
+     * @param node Korzen przetwarzanego poddrzewa.
+     * @param out Wektor wyjsciowy.
+     */
+    void collectInorder(Node* node, vector<Key>& out) const;
+
+    /**
+     * @brief Kopiuje klucze i (w trybie slownika) wartosci calego drzewa, rosnaco, na koniec wektorow.
+     * * Przechodzi drzewo ze stosem jak collectInorder - to kilka razy szybsze niz Iterator,
+     * ktory przy kazdym kroku w gore wraca przez wskazniki na rodzica.
+     * @param keys Wektor na klucze.
+     * @param values Wektor na wartosci (w drzewie bez wartosci pozostaje nietkniety).
+     */
+    void copyEntries(vector<Key>& keys, vector<Value>& values) const;
+
+    /**
+     * @brief Przenosi pary (klucz, wartosc) calego drzewa, rosnaco, na koniec wektora.
+     * * Wezly zostaja z wartosciami w stanie "po przeniesieniu" - nalezy je potem usunac (clear()).
+     * @param out Wektor wyjsciowy.
+     */
+    void moveEntriesOut(vector<pair<Key, Value>>& out);
+
+    /**
+     * @brief Wpina nowy wezel w miejsce znalezione przez locate() i przywraca warunek AVL.
+     * @param link Puste miejsce zwrocone przez locate().
+     * @param node Nowy wezel.
+     */
+    void attach(Node** link, Node* node);
+
+    /**
+     * @brief Zwraca pierwszy wezel, ktorego klucz nie lezy ponizej granicy (patrz countBelow).
+     * @param data Klucz odniesienia.
+     * @param inclusive Czy klucz rownowazny data lezy ponizej granicy.
+     * @return Znaleziony wezel albo nullptr, jesli wszystkie klucze leza ponizej.
+     */
+    Node* firstNotBelow(KeyArg data, bool inclusive) const;
+
+    /**
+     * @brief Szuka miejsca klucza, zapisujac sciezke w buforze path.
+     * @param data Szukany klucz.
+     * @return Wskaznik na wskaznik do wezla z kluczem albo na puste miejsce, w ktorym powinien sie znalezc.
+     */
+    Node** locate(KeyArg data);
+
+    /**
+     * @brief Fragment posortowanej tablicy do zbudowania i miejsce, w ktore trzeba wpiac jego korzen.
+     */
+    struct BuildRange {
+        Node** slot; ///< Wskaznik, pod ktory trafi korzen fragmentu.
+        Node* parent; ///< Rodzic korzenia fragmentu.
+        size_t begin; ///< Indeks pierwszej wartosci fragmentu.
+        size_t count; ///< Liczba wartosci fragmentu.
+    };
+
+    /**
+     * @brief Buduje idealnie zrownowazone drzewo z posortowanej tablicy bez duplikatow w czasie O(n).
+     * @param keys Posortowane rosnaco, unikalne wartosci.
+     * @param count Liczba wartosci.
+     * @param threads Liczba watkow budujacych poddrzewa.
+     * @return Korzen nowego poddrzewa (nullptr dla count == 0).
      */
-    Node* remove(Node* node, int data);
+    Node* buildBalanced(const Key* keys, size_t count, unsigned threads = 1);
 
     /**
-     * @brief Znajduje wezel o minimalnej wartosci w danym poddrzewie.
-     * @param node Korzen poddrzewa do przeszukania.
-     * @return Wskaznik na wezel z minimalna wartoscia.
+     * @brief Buduje idealnie zrownowazone drzewo z count posortowanych elementow w czasie O(n).
+     * * Przy threads > 1 gorne poziomy powstaja od razu, a ponizej nich niezalezne poddrzewa
+     * sa budowane rownolegle, kazde w osobnym, ciaglym obszarze pamieci z puli.
+     * @param count Liczba elementow.
+     * @param threads Liczba watkow budujacych poddrzewa.
+     * @param source Funkcja (void* pamiec, size_t indeks) -> Node*, tworzaca w pamieci wezel
+     * elementu o danym indeksie; wywolywana rownolegle dla roznych indeksow.
+     * @return Korzen nowego poddrzewa (nullptr dla count == 0).
      */
-    Node* findMin(Node* node);
+    template <typename Source>
+    Node* buildBalanced(size_t count, unsigned threads, Source source);
 
     /**
-     * @brief Prywatna, rekurencyjna metoda do usuwania wszystkich wezlow drzewa.
-     * @param node Aktualnie przetwarzany wezel.
+     * @brief Buduje idealnie zrownowazone poddrzewo w przygotowanym obszarze pamieci.
+     * * Wezly sa tworzone kolejno w porzadku Preorder, co `stride` bajtow od `memory`.
+     * Nie korzysta z puli, wiec moze dzialac na wielu watkach jednoczesnie.
+     * @param begin Indeks pierwszego elementu poddrzewa.
+     * @param count Liczba elementow (wieksza od zera).
+     * @param memory Obszar na `count` wezlow.
+     * @param stride Odstep miedzy kolejnymi wezlami w bajtach.
+     * @param source Funkcja tworzaca wezel elementu (patrz buildBalanced).
+     * @param parent Rodzic korzenia poddrzewa.
+     * @return Korzen nowego poddrzewa.
      */
-    void clear(Node* node);
+    template <typename Source>
+    static Node* buildRange(size_t begin, size_t count, char* memory, size_t stride, Source& source, Node* parent);
 
     /**
-     * @brief Prywatna, rekurencyjna metoda do znajdowania sciezki do elementu.
-     * @param node Aktualnie przetwarzany wezel.
-     * @param data Wartosc szukanego elementu.
-     * @param path Wektor przechowujacy sciezke (przekazywany przez referencje).
-     * @return true jesli element zostal znaleziony, false w przeciwnym razie.
+     * @brief Zwraca wysokosc idealnie zrownowazonego drzewa o count elementach (liczba bitow count).
+     * @param count Liczba elementow.
+     * @return Wysokosc drzewa.
      */
-    bool findPath(Node* node, int data, vector<int>& path);
+    static int rangeHeight(size_t count);
+
+    /**
+     * @brief Sortuje wektor: fragmenty rownolegle, potem scalanie parami (takze rownolegle).
+     * @param items Wektor do posortowania.
+     * @param threads Liczba watkow.
+     * @param less Porzadek elementow.
+     * @param stable Czy zachowac kolejnosc elementow rownowaznych (potrzebne dla par klucz-wartosc).
+     */
+    template <typename Item, typename Less>
+    static void parallelSort(vector<Item>& items, unsigned threads, Less less, bool stable);
 
     // --- Metody wyswietlania ---
 
     /**
      * @brief Wyswietla drzewo metoda Preorder (Korzen, Lewo, Prawo).
-     * @param node Aktualnie przetwarzany wezel.
+     * @param node Korzen przetwarzanego poddrzewa.
      */
     void printPreorder(Node* node);
 
     /**
      * @brief Wyswietla drzewo metoda Inorder (Lewo, Korzen, Prawo).
-     * @param node Aktualnie przetwarzany wezel.
+     * @param node Korzen przetwarzanego poddrzewa.
      */
     void printInorder(Node* node);
 
     /**
      * @brief Wyswietla drzewo metoda Postorder (Lewo, Prawo, Korzen).
-     * @param node Aktualnie przetwarzany wezel.
+     * @param node Korzen przetwarzanego poddrzewa.
      */
     void printPostorder(Node* node);
 
     /**
      * @brief Wyswietla drzewo graficznie (w orientacji poziomej).
-     * @param node Aktualnie przetwarzany wezel.
-     * @param space Aktualne wciecie (liczba spacji).
+     * @param node Korzen wyswietlanego poddrzewa.
+     * @param space Poczatkowe wciecie (liczba spacji).
      * @param count Liczba spacji dodawana na kazdym poziomie.
      */
     void printGraphical(Node* node, int space, int count);
@@ -115,46 +447,215 @@ private:
 
     /**
      * @brief Zapisuje drzewo do pliku tekstowego (w kolejnosci Inorder).
-     * @param node Aktualnie przetwarzany wezel.
+     * @param node Korzen przetwarzanego poddrzewa.
      * @param outFile Strumien wyjsciowy pliku.
      */
     void saveToText(Node* node, ofstream& outFile);
 
     /**
-     * @brief Serializuje (zapisuje binarnie) strukture drzewa (w kolejnosci Preorder).
-     * @param node Aktualnie przetwarzany wezel.
+     * @brief Serializuje (zapisuje binarnie) zawartosc drzewa w formacie v2 (bez naglowka).
+     * * Wartosci sa zapisywane w kolejnosci Inorder (rosnaco) przez KeyCodec: dla int
+     * pierwsza jako varint w kodowaniu zigzag, kolejne jako varint roznicy wzgledem
+     * poprzedniej wartosci. Dane trafiaja do pliku duzymi blokami.
+     * @param node Korzen przetwarzanego poddrzewa.
      * @param outFile Strumien wyjsciowy pliku binarnego.
      */
     void serialize(Node* node, ofstream& outFile);
 
     /**
-     * @brief Deserializuje (odczytuje binarnie) strukture drzewa.
+     * @brief Deserializuje (odczytuje binarnie) zawartosc drzewa w formacie v2 i zastepuje nia drzewo.
+     * * Drzewo jest budowane jako idealnie zrownowazone (BST::buildBalanced). Jesli dane sa
+     * uszkodzone, drzewo pozostaje nienaruszone.
+     * @param inFile Strumien wejsciowy ustawiony za naglowkiem pliku.
+     * @param count Liczba wartosci zapisanych w pliku (z naglowka).
+     * @param threads Liczba watkow budujacych drzewo.
+     * @return true jesli odczyt sie powiodl, false w przeciwnym razie.
+     */
+    bool deserialize(ifstream& inFile, unsigned long long count, unsigned threads);
+
+    /**
+     * @brief Deserializuje strukture drzewa ze starego formatu (Preorder ze znacznikami bool).
+     * * Pozostawiona dla zgodnosci z plikami zapisanymi przed wprowadzeniem formatu v2.
+     * Klucze sa odczytywane jako surowe bajty.
+     * Ustawia licznik wezlow na liczbe odczytanych wezlow.
      * @param inFile Strumien wejsciowy pliku binarnego.
      * @return Wskaznik na odtworzony wezel (lub nullptr).
      */
-    Node* deserialize(ifstream& inFile);
+    Node* deserializeLegacy(ifstream& inFile);
 
 public:
-    /// @brief Konstruktor domyslny, tworzy puste drzewo.
-    BST();
+    /**
+     * @brief Dwukierunkowy iterator po kluczach w kolejnosci rosnacej (zgodny z STL).
+     * * Nie alokuje pamieci: kolejny wezel znajduje po wskaznikach na dzieci i rodzica,
+     * w zamortyzowanym czasie O(1). Klucze sa tylko do odczytu - ich zmiana zepsulaby
+     * porzadek drzewa. Dodawanie elementow nie uniewaznia iteratorow; usuniecie elementu
+     * uniewaznia iteratory na niego i na jego nastepnika, a clear(), bulkLoad() i wczytanie
+     * pliku - wszystkie.
+     */
+    class Iterator {
+    public:
+        typedef bidirectional_iterator_tag iterator_category;
+        typedef Key value_type;
+        typedef ptrdiff_t difference_type;
+        typedef const Key* pointer;
+        typedef const Key& reference;
+
+        /// @brief Tworzy iterator niezwiazany z zadnym drzewem.
+        Iterator() : node(nullptr), tree(nullptr) {}
+
+        /// @brief Zwraca klucz biezacego elementu.
+        reference operator*() const { return node->data; }
+
+        /// @brief Zwraca wskaznik na klucz biezacego elementu.
+        pointer operator->() const { return &node->data; }
+
+        /// @brief Zwraca wartosc przypisana do biezacego klucza (tryb slownika).
+        const Value& value() const { return *node->get(); }
+
+        /// @brief Przechodzi do nastepnego (wiekszego) klucza.
+        Iterator& operator++();
+
+        /// @brief Przechodzi do poprzedniego (mniejszego) klucza; z end() - do najwiekszego.
+        Iterator& operator--();
+
+        /// @brief Wersja przyrostkowa operatora ++.
+        Iterator operator++(int) {
+            Iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        /// @brief Wersja przyrostkowa operatora --.
+        Iterator operator--(int) {
+            Iterator old = *this;
+            --*this;
+            return old;
+        }
+
+        bool operator==(const Iterator& other) const { return node == other.node; }
+        bool operator!=(const Iterator& other) const { return node != other.node; }
+
+    private:
+        Node* node; ///< Biezacy wezel (nullptr dla end()).
+        const BasicBST* tree; ///< Drzewo - potrzebne, aby cofnac sie z end().
+
+        Iterator(Node* node, const BasicBST* tree) : node(node), tree(tree) {}
+
+        friend class BasicBST;
+    };
+
+    typedef Iterator iterator; ///< Nazwa wymagana przez algorytmy STL.
+    typedef Iterator const_iterator; ///< Klucze sa zawsze tylko do odczytu.
+
+    /**
+     * @brief Konstruktor, tworzy puste drzewo.
+     * @param balanced Jesli true (domyslnie), drzewo utrzymuje warunek AVL, dzieki czemu
+     * wysokosc pozostaje logarytmiczna takze dla posortowanych danych wejsciowych.
+     * @param comp Porzadek kluczy.
+     * @param allocator Alokator pamieci wezlow.
+     */
+    explicit BasicBST(bool balanced = true, const Compare& comp = Compare(), const Allocator& allocator = Allocator());
 
     /// @brief Destruktor, zwalnia pamiec po wszystkich wezlach.
-    ~BST();
+    ~BasicBST();
+
+    BasicBST(const BasicBST&) = delete;
+    BasicBST& operator=(const BasicBST&) = delete;
 
     /**
      * @brief Publiczna metoda dodajaca element do drzewa.
+     * * W trybie slownika nowy klucz dostaje wartosc utworzona konstruktorem domyslnym.
      * @param data Wartosc do dodania.
      */
-    void insert(int data);
+    void insert(KeyArg data);
+
+    /**
+     * @brief Dodaje klucz, tworzac jego wartosc w miejscu (bez kopiowania i przenoszenia).
+     * * Jesli klucz juz istnieje, drzewo i argumenty pozostaja nienaruszone.
+     * @param data Klucz.
+     * @param args Argumenty konstruktora wartosci.
+     * @return Para: wskaznik na wartosc klucza (nowa lub istniejaca) i true, jesli klucz zostal dodany.
+     */
+    template <typename... Args>
+    pair<Value*, bool> emplace(KeyArg data, Args&&... args);
+
+    /**
+     * @brief Dodaje klucz z wartoscia albo zastepuje wartosc istniejacego klucza.
+     * @param data Klucz.
+     * @param value Wartosc (przenoszona, jesli przekazano r-wartosc).
+     * @return true jesli klucz zostal dodany, false jesli zastapiono wartosc.
+     */
+    template <typename V>
+    bool insertOrAssign(KeyArg data, V&& value);
+
+    /**
+     * @brief Wyszukuje wartosc przypisana do klucza.
+     * * Wskaznik pozostaje wazny do usuniecia klucza lub wyczyszczenia drzewa.
+     * @param data Szukany klucz.
+     * @return Wskaznik na wartosc w wezle albo nullptr, jesli klucza nie ma.
+     */
+    Value* find(KeyArg data);
+
+    /**
+     * @brief Wyszukuje wartosc przypisana do klucza (wersja stala).
+     * @param data Szukany klucz.
+     * @return Wskaznik na wartosc w wezle albo nullptr, jesli klucza nie ma.
+     */
+    const Value* find(KeyArg data) const;
+
+    /**
+     * @brief Dodaje wiele elementow naraz, przebudowujac drzewo w czasie liniowym.
+     * * Wartosci sa sortowane (jesli nie sa juz posortowane) i pozbawiane duplikatow,
+     * scalane z zawartoscia drzewa, a nastepnie drzewo jest budowane od nowa jako
+     * idealnie zrownowazone. Dziala zarowno dla pustego, jak i niepustego drzewa.
+     * Przy threads > 1 sortowanie (fragmentami, a potem scalanie) i budowa poddrzew
+     * odbywaja sie rownolegle.
+     * W trybie slownika nowe klucze dostaja wartosci utworzone konstruktorem domyslnym.
+     * @param keys Wartosci do dodania (w dowolnej kolejnosci, moga sie powtarzac).
+     * @param threads Liczba watkow; 0 oznacza liczbe rdzeni procesora.
+     */
+    void bulkLoad(vector<Key> keys, unsigned threads = 1);
+
+    /**
+     * @brief Dodaje wiele par (klucz, wartosc) naraz, przebudowujac drzewo w czasie liniowym.
+     * * Wartosci sa przenoszone do wezlow. Klucze juz obecne w drzewie zachowuja swoje
+     * wartosci, a z powtorzen w `entries` liczy sie pierwsze wystapienie - tak jak przy emplace.
+     * @param entries Pary do dodania (w dowolnej kolejnosci).
+     * @param threads Liczba watkow; 0 oznacza liczbe rdzeni procesora.
+     */
+    void bulkLoad(vector<pair<Key, Value>> entries, unsigned threads = 1);
+
+    /**
+     * @brief Dodaje wsad kluczy jednym skoordynowanym przebiegiem.
+     * * Wsad jest sortowany, a nastepnie - zaleznie od jego rozmiaru wzgledem drzewa -
+     * dodawany kolejno w porzadku rosnacym (kolejne zejscia dziela gorna czesc sciezki,
+     * ktora zostaje w pamieci podrecznej) albo scalany z drzewem i przebudowywany (bulkLoad).
+     * W trybie slownika nowe klucze dostaja wartosci utworzone konstruktorem domyslnym.
+     * @param keys Klucze do dodania (w dowolnej kolejnosci, moga sie powtarzac).
+     * @param threads Liczba watkow sortowania i przebudowy; 0 oznacza liczbe rdzeni procesora.
+     * @param mode Sposob wykonania (domyslnie wybierany automatycznie).
+     */
+    void insertBatch(vector<Key> keys, unsigned threads = 1, BatchMode mode = BatchMode::Auto);
+
+    /**
+     * @brief Usuwa wsad kluczy jednym skoordynowanym przebiegiem.
+     * * Jak insertBatch: kolejne usuniecia w porzadku rosnacym albo jeden przebieg
+     * odfiltrowujacy klucze z zawartosci drzewa i przebudowa.
+     * @param keys Klucze do usuniecia (w dowolnej kolejnosci; brakujace sa pomijane).
+     * @param threads Liczba watkow sortowania i przebudowy; 0 oznacza liczbe rdzeni procesora.
+     * @param mode Sposob wykonania (domyslnie wybierany automatycznie).
+     */
+    void removeBatch(vector<Key> keys, unsigned threads = 1, BatchMode mode = BatchMode::Auto);
 
     /**
      * @brief Publiczna metoda usuwajaca element z drzewa.
      * @param data Wartosc do usuniecia.
      */
-    void remove(int data);
+    void remove(KeyArg data);
 
     /**
      * @brief Publiczna metoda usuwajaca wszystkie elementy z drzewa.
+     * * Dziala w czasie O(1) - cala pamiec wezlow wraca do puli naraz.
      */
     void clear();
 
@@ -164,7 +665,125 @@ public:
      * @return Wektor (STL) zawierajacy wartosci wezlow na sciezce.
      * Pusty wektor, jesli elementu nie znaleziono.
      */
-    vector<int> findPath(int data);
+    vector<Key> findPath(KeyArg data) const;
+
+    /**
+     * @brief Wyszukuje sciezke, zapisujac ja do wektora podanego przez wywolujacego.
+     * * Po pierwszych zapytaniach pojemnosc wektora wystarcza i zapytanie nie alokuje pamieci.
+     * @param data Wartosc do znalezienia.
+     * @param path Wektor na sciezke (poprzednia zawartosc jest zastepowana; pusty, jesli nie znaleziono).
+     * @return true jesli element zostal znaleziony.
+     */
+    bool findPath(KeyArg data, vector<Key>& path) const;
+
+    /**
+     * @brief Wyszukuje sciezke, zapisujac ja do bufora podanego przez wywolujacego (bez alokacji).
+     * * Bufor o rozmiarze getHeight() zawsze wystarcza. Przy mniejszym buforze zapisywany
+     * jest tylko poczatek sciezki, a wynik nadal podaje jej pelna dlugosc.
+     * @param data Wartosc do znalezienia.
+     * @param out Bufor na klucze wezlow sciezki.
+     * @param capacity Rozmiar bufora.
+     * @return Dlugosc sciezki (liczba wezlow od korzenia do elementu) albo 0, jesli nie znaleziono.
+     */
+    size_t findPath(KeyArg data, Key* out, size_t capacity) const;
+
+    /**
+     * @brief Zwraca glebokosc elementu bez zapisywania sciezki.
+     * @param data Wartosc do znalezienia.
+     * @return Liczba wezlow od korzenia do elementu (1 dla korzenia) albo 0, jesli nie znaleziono.
+     */
+    size_t findDepth(KeyArg data) const;
+
+    /**
+     * @brief Sprawdza, czy element wystepuje w drzewie.
+     * @param data Szukana wartosc.
+     * @return true jesli element zostal znaleziony.
+     */
+    bool contains(KeyArg data) const;
+
+    /**
+     * @brief Zwraca k-ty najmniejszy klucz w czasie O(log n).
+     * @param k Pozycja klucza, liczona od 0.
+     * @return Wskaznik na klucz w wezle albo nullptr, jesli k >= getSize().
+     */
+    const Key* select(size_t k) const;
+
+    /**
+     * @brief Zwraca pozycje klucza w czasie O(log n).
+     * @param data Klucz (nie musi wystepowac w drzewie).
+     * @return Liczba kluczy mniejszych od data - dla klucza z drzewa jego pozycja liczona od 0.
+     */
+    size_t rank(KeyArg data) const;
+
+    /**
+     * @brief Liczy klucze z przedzialu domknietego [low, high] w czasie O(log n).
+     * @param low Dolna granica.
+     * @param high Gorna granica.
+     * @return Liczba kluczy (0, jesli high < low).
+     */
+    size_t countRange(KeyArg low, KeyArg high) const;
+
+    /// @brief Zwraca iterator na najmniejszy klucz (O(log n), bez alokacji).
+    Iterator begin() const;
+
+    /// @brief Zwraca iterator za ostatnim kluczem.
+    Iterator end() const;
+
+    /**
+     * @brief Zwraca iterator na pierwszy klucz nie mniejszy od podanego.
+     * @param data Klucz odniesienia.
+     * @return Iterator na znaleziony klucz albo end().
+     */
+    Iterator lowerBound(KeyArg data) const;
+
+    /**
+     * @brief Zwraca iterator na pierwszy klucz wiekszy od podanego.
+     * @param data Klucz odniesienia.
+     * @return Iterator na znaleziony klucz albo end().
+     */
+    Iterator upperBound(KeyArg data) const;
+
+    /**
+     * @brief Zwraca przedzial kluczy rownowaznych podanemu (pusty albo jednoelementowy).
+     * @param data Klucz odniesienia.
+     * @return Para (lowerBound(data), upperBound(data)).
+     */
+    pair<Iterator, Iterator> equalRange(KeyArg data) const;
+
+    /**
+     * @brief Tworzy niezmienna, przyjazna dla pamieci podrecznej kopie drzewa.
+     * * Zwrocony indeks nie widzi pozniejszych zmian w drzewie. Dostepne tylko dla kluczy int.
+     * @return Indeks FrozenBST z aktualnymi wartosciami drzewa.
+     */
+    FrozenBST freeze() const;
+
+    /**
+     * @brief Zwraca aktualna wysokosc drzewa.
+     * @return Liczba poziomow drzewa (0 dla pustego drzewa).
+     */
+    int getHeight() const;
+
+    /**
+     * @brief Zwraca liczbe elementow w drzewie.
+     * @return Liczba wezlow.
+     */
+    size_t getSize() const;
+
+    /**
+     * @brief Sprawdza, czy drzewo dziala w trybie samowywazajacym (AVL).
+     * @return true jesli drzewo jest rownowazone.
+     */
+    bool isBalanced() const;
+
+    /**
+     * @brief Zwraca migawke statystyk drzewa (patrz Stats.h).
+     * * Liczba wezlow, wysokosc i pamiec sa dostepne zawsze; liczniki zdarzen tylko przy BST_STATS=1.
+     * @return Aktualne statystyki.
+     */
+    TreeStats getStats() const;
+
+    /// @brief Zeruje liczniki zdarzen (nie wplywa na zawartosc drzewa).
+    void resetStats();
 
     /**
      * @brief Wyswietla menu wyboru metody wyswietlania drzewa i je wyswietla.
@@ -172,9 +791,22 @@ public:
     void display();
 
     /**
-     * @brief Zaprzyjaznienie klasy FileHandler.
+     * @brief Zaprzyjaznienie szablonu BasicFileHandler.
      * * Pozwala klasie FileHandler na dostep do prywatnych skladowych (root)
      * i prywatnych metod (serialize, deserialize, saveToText) klasy BST.
      */
-    friend class FileHandler;
+    template <typename, typename, typename, typename>
+    friend class BasicFileHandler;
 };
+
+#include "BST.tpp"
+
+/// @brief Drzewo z kluczami int - typ uzywany w calym programie.
+typedef BasicBST<> BST;
+
+/// @brief Drzewo w trybie slownika (kazdy klucz ma wartosc typu Value).
+template <typename Key, typename Value, typename Compare = less<Key>, typename Allocator = allocator<Key>>
+using BasicBSTMap = BasicBST<Key, Compare, Allocator, Value>;
+
+// Drzewo int jest instancjonowane raz, w BST.cpp
+extern template class BasicBST<>;
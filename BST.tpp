@@ -0,0 +1,1157 @@
+﻿/**
+ * @file BST.tpp
+ * @brief Implementacja metod szablonu BasicBST (dolaczana na koncu BST.h).
+ */
+
+#pragma once
+
+#include <algorithm> // Do max, min, sort, stable_sort, unique, set_union, set_difference, merge, lower_bound
+#include <iterator> // Do back_inserter, make_move_iterator
+#include <new> // Placement new dla wezlow z puli
+#include <utility> // Do move, pair
+
+#include "ParallelTasks.h"
+
+ // --- Konstruktor i Destruktor ---
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+BasicBST<Key, Compare, Allocator, Value>::BasicBST(bool balanced, const Compare& comp, const Allocator& allocator)
+    : root(nullptr), nodeCount(0), balanced(balanced), comp(comp), pool(sizeof(Node), SlabAllocator(allocator)) {}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+BasicBST<Key, Compare, Allocator, Value>::~BasicBST() {
+    // Pamiec wezlow zwalnia destruktor puli
+    destroyKeys();
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+template <typename... Args>
+typename BasicBST<Key, Compare, Allocator, Value>::Node* BasicBST<Key, Compare, Allocator, Value>::createNode(KeyArg data, Args&&... args) {
+    counters.allocation(1);
+    return new (pool.allocate()) Node(data, forward<Args>(args)...);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+void BasicBST<Key, Compare, Allocator, Value>::destroyNode(Node* node) {
+    counters.deallocation();
+    node->~Node();
+    pool.deallocate(node);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+void BasicBST<Key, Compare, Allocator, Value>::destroyKeys() {
+    if (is_trivially_destructible<Node>::value) {
+        return; // Warunek znany w czasie kompilacji - dla int petla znika
+    }
+    vector<Node*> stack;
+    if (root != nullptr) stack.push_back(root);
+    while (!stack.empty()) {
+        Node* node = stack.back();
+        stack.pop_back();
+        if (node->left != nullptr) stack.push_back(node->left);
+        if (node->right != nullptr) stack.push_back(node->right);
+        node->~Node();
+    }
+}
+
+// --- Rownowazenie (AVL) ---
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+int BasicBST<Key, Compare, Allocator, Value>::height(Node* node) {
+    return node ? node->height : 0;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+size_t BasicBST<Key, Compare, Allocator, Value>::subtreeSize(Node* node) {
+    return node ? node->size : 0;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+void BasicBST<Key, Compare, Allocator, Value>::updateNode(Node* node) {
+    node->height = 1 + max(height(node->left), height(node->right));
+    node->size = 1 + subtreeSize(node->left) + subtreeSize(node->right);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+typename BasicBST<Key, Compare, Allocator, Value>::Node* BasicBST<Key, Compare, Allocator, Value>::leftmost(Node* node) {
+    while (node->left != nullptr) {
+        node = node->left;
+    }
+    return node;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+typename BasicBST<Key, Compare, Allocator, Value>::Node* BasicBST<Key, Compare, Allocator, Value>::rightmost(Node* node) {
+    while (node->right != nullptr) {
+        node = node->right;
+    }
+    return node;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+typename BasicBST<Key, Compare, Allocator, Value>::Node* BasicBST<Key, Compare, Allocator, Value>::rotateLeft(Node* node) {
+    Node* pivot = node->right;
+    node->right = pivot->left;
+    if (node->right != nullptr) node->right->parent = node;
+    pivot->left = node;
+    pivot->parent = node->parent;
+    node->parent = pivot;
+    updateNode(node);
+    updateNode(pivot);
+    return pivot;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+typename BasicBST<Key, Compare, Allocator, Value>::Node* BasicBST<Key, Compare, Allocator, Value>::rotateRight(Node* node) {
+    Node* pivot = node->left;
+    node->left = pivot->right;
+    if (node->left != nullptr) node->left->parent = node;
+    pivot->right = node;
+    pivot->parent = node->parent;
+    node->parent = pivot;
+    updateNode(node);
+    updateNode(pivot);
+    return pivot;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+typename BasicBST<Key, Compare, Allocator, Value>::Node* BasicBST<Key, Compare, Allocator, Value>::rebalance(Node* node) {
+    updateNode(node);
+    if (!balanced) {
+        return node;
+    }
+
+    int balance = height(node->left) - height(node->right);
+    if (balance > 1) {
+        // Lewe poddrzewo za wysokie; przypadek Lewo-Prawo wymaga podwojnej rotacji
+        if (height(node->left->left) < height(node->left->right)) {
+            node->left = rotateLeft(node->left);
+            counters.rotation();
+        }
+        counters.rotation();
+        return rotateRight(node);
+    }
+    if (balance < -1) {
+        // Prawe poddrzewo za wysokie; przypadek Prawo-Lewo wymaga podwojnej rotacji
+        if (height(node->right->right) < height(node->right->left)) {
+            node->right = rotateRight(node->right);
+            counters.rotation();
+        }
+        counters.rotation();
+        return rotateLeft(node);
+    }
+    return node;
+}
+
+// --- Prywatne metody pomocnicze ---
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+void BasicBST<Key, Compare, Allocator, Value>::retrace(size_t depth) {
+    while (depth > 0) {
+        Node** link = path[--depth];
+        int before = (*link)->height;
+        *link = rebalance(*link);
+        if ((*link)->height == before) {
+            break; // Wysokosc poddrzewa sie nie zmienila, wyzsze poziomy sa juz poprawne
+        }
+    }
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+void BasicBST<Key, Compare, Allocator, Value>::resize(ptrdiff_t delta) {
+    // Rotacje w retrace przeliczaja rozmiar tylko obracanych wezlow, wiec przodkow
+    // poprawiamy wczesniej - wszystkie, bo retrace moze skonczyc sie przed korzeniem
+    for (size_t i = 0; i < path.size(); i++) {
+        (*path[i])->size += static_cast<size_t>(delta);
+    }
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+void BasicBST<Key, Compare, Allocator, Value>::attach(Node** link, Node* node) {
+    node->parent = path.empty() ? nullptr : *path.back();
+    *link = node;
+    nodeCount++;
+    counters.insertion();
+    resize(1);
+    retrace(path.size());
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+typename BasicBST<Key, Compare, Allocator, Value>::Node* BasicBST<Key, Compare, Allocator, Value>::firstNotBelow(KeyArg data, bool inclusive) const {
+    Node* result = nullptr;
+    Node* node = root;
+    while (node != nullptr) {
+        bool below = inclusive ? !comp(data, node->data) : comp(node->data, data);
+        if (below) {
+            node = node->right;
+        }
+        else {
+            result = node; // Kandydat; mniejszy moze byc jeszcze w lewym poddrzewie
+            node = node->left;
+        }
+    }
+    return result;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+bool BasicBST<Key, Compare, Allocator, Value>::preferRebuild(size_t batch, BatchMode mode) const {
+    if (mode != BatchMode::Auto) {
+        return mode == BatchMode::Rebuild;
+    }
+    // Wysokosc po wsadzie, nie przed nim - wstawianie duzego wsadu do pustego lub malego
+    // drzewa przechodzi przez coraz wyzsze drzewo
+    size_t levels = static_cast<size_t>(rangeHeight(nodeCount + batch));
+    return batch * levels >= batchRebuildCost * (nodeCount + batch);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+size_t BasicBST<Key, Compare, Allocator, Value>::countBelow(KeyArg data, bool inclusive) const {
+    size_t count = 0;
+    Node* node = root;
+    while (node != nullptr) {
+        bool below = inclusive ? !comp(data, node->data) : comp(node->data, data);
+        if (below) {
+            // Wezel i cale jego lewe poddrzewo leza ponizej granicy
+            count += subtreeSize(node->left) + 1;
+            node = node->right;
+        }
+        else {
+            node = node->left;
+        }
+    }
+    return count;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+void BasicBST<Key, Compare, Allocator, Value>::collectInorder(Node* node, vector<Key>& out) const {
+    vector<Node*> stack;
+    while (node != nullptr || !stack.empty()) {
+        while (node != nullptr) {
+            stack.push_back(node);
+            node = node->left;
+        }
+        node = stack.back();
+        stack.pop_back();
+        out.push_back(node->data);
+        node = node->right;
+    }
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+void BasicBST<Key, Compare, Allocator, Value>::copyEntries(vector<Key>& keys, vector<Value>& values) const {
+    Node* node = root;
+    vector<Node*> stack;
+    while (node != nullptr || !stack.empty()) {
+        while (node != nullptr) {
+            stack.push_back(node);
+            node = node->left;
+        }
+        node = stack.back();
+        stack.pop_back();
+        keys.push_back(node->data);
+        if (HasValue::value) {
+            values.push_back(*node->get());
+        }
+        node = node->right;
+    }
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+void BasicBST<Key, Compare, Allocator, Value>::moveEntriesOut(vector<pair<Key, Value>>& out) {
+    Node* node = root;
+    vector<Node*> stack;
+    while (node != nullptr || !stack.empty()) {
+        while (node != nullptr) {
+            stack.push_back(node);
+            node = node->left;
+        }
+        node = stack.back();
+        stack.pop_back();
+        out.emplace_back(node->data, move(*node->get()));
+        node = node->right;
+    }
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+typename BasicBST<Key, Compare, Allocator, Value>::Node** BasicBST<Key, Compare, Allocator, Value>::locate(KeyArg data) {
+    path.clear();
+    Node** link = &root;
+    while (*link != nullptr) {
+        bool goLeft;
+        if (matches(data, (*link)->data, goLeft)) {
+            break;
+        }
+        path.push_back(link);
+        link = goLeft ? &(*link)->left : &(*link)->right;
+    }
+    return link;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+typename BasicBST<Key, Compare, Allocator, Value>::Node* BasicBST<Key, Compare, Allocator, Value>::buildBalanced(const Key* keys, size_t count, unsigned threads) {
+    return buildBalanced(count, threads, [keys](void* memory, size_t i) {
+        return new (memory) Node(keys[i]);
+    });
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+template <typename Source>
+typename BasicBST<Key, Compare, Allocator, Value>::Node* BasicBST<Key, Compare, Allocator, Value>::buildBalanced(size_t count, unsigned threads, Source source) {
+    Node* result = nullptr;
+    if (count == 0) {
+        return result;
+    }
+    counters.rebuild();
+    counters.allocation(count);
+
+    // Fragmenty nie wieksze niz grain staja sie zadaniami; przy jednym watku calosc
+    // jest jednym zadaniem budowanym w jednym, ciaglym obszarze pamieci
+    size_t grain = count;
+    if (threads > 1) {
+        grain = max(count / (static_cast<size_t>(threads) * 4), static_cast<size_t>(minParallelRange));
+    }
+
+    vector<BuildRange> stack; // Glebokosc stosu to O(log n)
+    vector<BuildRange> tasks;
+    stack.push_back(BuildRange{ &result, nullptr, 0, count });
+    while (!stack.empty()) {
+        BuildRange range = stack.back();
+        stack.pop_back();
+        if (range.count <= grain) {
+            tasks.push_back(range);
+            continue;
+        }
+
+        size_t leftCount = range.count / 2;
+        size_t rightCount = range.count - leftCount - 1;
+        Node* node = source(pool.allocate(), range.begin + leftCount);
+        node->height = rangeHeight(range.count);
+        node->size = range.count;
+        node->parent = range.parent;
+        *range.slot = node;
+        if (rightCount > 0) {
+            stack.push_back(BuildRange{ &node->right, node, range.begin + leftCount + 1, rightCount });
+        }
+        if (leftCount > 0) {
+            stack.push_back(BuildRange{ &node->left, node, range.begin, leftCount });
+        }
+    }
+
+    // Pamiec dla zadan przydzielamy z puli zawczasu - sama pula nie jest bezpieczna dla watkow
+    vector<char*> memory(tasks.size());
+    for (size_t i = 0; i < tasks.size(); i++) {
+        memory[i] = static_cast<char*>(pool.allocateRun(tasks[i].count));
+    }
+    size_t stride = pool.getBlockSize();
+    ParallelTasks::run(tasks.size(), threads, [&](size_t i) {
+        *tasks[i].slot = buildRange(tasks[i].begin, tasks[i].count, memory[i], stride, source, tasks[i].parent);
+    });
+    return result;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+template <typename Source>
+typename BasicBST<Key, Compare, Allocator, Value>::Node* BasicBST<Key, Compare, Allocator, Value>::buildRange(size_t begin, size_t count, char* memory, size_t stride, Source& source, Node* parent) {
+    Node* result = nullptr;
+    vector<BuildRange> stack; // Glebokosc stosu to O(log n)
+    stack.push_back(BuildRange{ &result, parent, begin, count });
+
+    while (!stack.empty()) {
+        BuildRange range = stack.back();
+        stack.pop_back();
+
+        size_t leftCount = range.count / 2;
+        size_t rightCount = range.count - leftCount - 1;
+        Node* node = source(memory, range.begin + leftCount);
+        memory += stride;
+        node->height = rangeHeight(range.count);
+        node->size = range.count;
+        node->parent = range.parent;
+        *range.slot = node;
+
+        if (rightCount > 0) {
+            stack.push_back(BuildRange{ &node->right, node, range.begin + leftCount + 1, rightCount });
+        }
+        if (leftCount > 0) {
+            stack.push_back(BuildRange{ &node->left, node, range.begin, leftCount });
+        }
+    }
+    return result;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+int BasicBST<Key, Compare, Allocator, Value>::rangeHeight(size_t count) {
+    // Lewe poddrzewo jest zawsze co najmniej tak liczne jak prawe
+    int levels = 0;
+    for (; count > 0; count >>= 1) {
+        levels++;
+    }
+    return levels;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+template <typename Item, typename Less>
+void BasicBST<Key, Compare, Allocator, Value>::parallelSort(vector<Item>& items, unsigned threads, Less less, bool stable) {
+    size_t chunks = min(static_cast<size_t>(threads), items.size() / minParallelRange);
+    if (chunks <= 1) {
+        if (stable) {
+            stable_sort(items.begin(), items.end(), less);
+        }
+        else {
+            sort(items.begin(), items.end(), less);
+        }
+        return;
+    }
+
+    vector<size_t> bounds(chunks + 1);
+    for (size_t i = 0; i <= chunks; i++) {
+        bounds[i] = items.size() * i / chunks;
+    }
+    ParallelTasks::run(chunks, threads, [&](size_t i) {
+        if (stable) {
+            stable_sort(items.begin() + bounds[i], items.begin() + bounds[i + 1], less);
+        }
+        else {
+            sort(items.begin() + bounds[i], items.begin() + bounds[i + 1], less);
+        }
+    });
+
+    // Scalanie jest stabilne (przy rownych elementach pierwszenstwo ma lewy ciag),
+    // a elementy sa przenoszone, wiec dziala tez dla wartosci tylko przenoszalnych
+    vector<Item> buffer(items.size());
+    for (size_t width = 1; width < chunks; width *= 2) {
+        size_t pairs = (chunks + 2 * width - 1) / (2 * width);
+        // Kazda pare dzielimy na czesci, aby ostatnie poziomy tez zajely wszystkie watki:
+        // czesc q zaczyna sie od q-tej czesci lewego ciagu i odpowiadajacego jej miejsca w prawym
+        size_t parts = max(static_cast<size_t>(1), threads / pairs);
+        ParallelTasks::run(pairs * parts, threads, [&](size_t task) {
+            size_t pair = task / parts;
+            size_t part = task % parts;
+            size_t first = pair * 2 * width;
+            Item* leftBegin = items.data() + bounds[first];
+            Item* leftEnd = items.data() + bounds[min(first + width, chunks)];
+            Item* rightBegin = leftEnd;
+            Item* rightEnd = items.data() + bounds[min(first + 2 * width, chunks)];
+
+            auto split = [&](Item* position) {
+                return (position == leftEnd) ? rightEnd : lower_bound(rightBegin, rightEnd, *position, less);
+            };
+            size_t leftSize = leftEnd - leftBegin;
+            Item* aBegin = leftBegin + leftSize * part / parts;
+            Item* aEnd = leftBegin + leftSize * (part + 1) / parts;
+            Item* bBegin = (part == 0) ? rightBegin : split(aBegin);
+            Item* bEnd = (part + 1 == parts) ? rightEnd : split(aEnd);
+            Item* out = buffer.data() + bounds[first] + (aBegin - leftBegin) + (bBegin - rightBegin);
+            merge(make_move_iterator(aBegin), make_move_iterator(aEnd),
+                make_move_iterator(bBegin), make_move_iterator(bEnd), out, less);
+        });
+        items.swap(buffer);
+    }
+}
+
+// --- Metody wyswietlania ---
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+void BasicBST<Key, Compare, Allocator, Value>::printPreorder(Node* node) {
+    vector<Node*> stack;
+    if (node != nullptr) stack.push_back(node);
+    while (!stack.empty()) {
+        Node* current = stack.back();
+        stack.pop_back();
+        cout << current->data << " ";
+        if (current->right != nullptr) stack.push_back(current->right);
+        if (current->left != nullptr) stack.push_back(current->left);
+    }
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+void BasicBST<Key, Compare, Allocator, Value>::printInorder(Node* node) {
+    vector<Node*> stack;
+    while (node != nullptr || !stack.empty()) {
+        while (node != nullptr) {
+            stack.push_back(node);
+            node = node->left;
+        }
+        node = stack.back();
+        stack.pop_back();
+        cout << node->data << " ";
+        node = node->right;
+    }
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+void BasicBST<Key, Compare, Allocator, Value>::printPostorder(Node* node) {
+    vector<Node*> stack;
+    Node* lastVisited = nullptr;
+    while (node != nullptr || !stack.empty()) {
+        while (node != nullptr) {
+            stack.push_back(node);
+            node = node->left;
+        }
+        Node* top = stack.back();
+        if (top->right != nullptr && top->right != lastVisited) {
+            node = top->right; // Najpierw prawe poddrzewo
+        }
+        else {
+            cout << top->data << " ";
+            lastVisited = top;
+            stack.pop_back();
+        }
+    }
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+void BasicBST<Key, Compare, Allocator, Value>::printGraphical(Node* node, int space, int count) {
+    // Odwrotny Inorder (Prawo, Korzen, Lewo), na stosie trzymamy wezel i jego wciecie
+    vector<pair<Node*, int>> stack;
+    space += count;
+    while (node != nullptr || !stack.empty()) {
+        while (node != nullptr) {
+            stack.push_back(make_pair(node, space));
+            node = node->right;
+            space += count;
+        }
+        node = stack.back().first;
+        space = stack.back().second;
+        stack.pop_back();
+
+        cout << endl;
+        for (int i = count; i < space; i++) {
+            cout << " ";
+        }
+        cout << node->data << "\n";
+
+        node = node->left;
+        space += count;
+    }
+}
+
+// --- Metody pomocnicze do zapisu/odczytu ---
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+void BasicBST<Key, Compare, Allocator, Value>::saveToText(Node* node, ofstream& outFile) {
+    // Zapisujemy Inorder, aby plik tekstowy byl posortowany.
+    // Kodek formatuje liczby do bufora i zapisuje je do pliku duzymi blokami.
+    // W trybie slownika wartosc stoi w tej samej linii co klucz.
+    typename Codec::TextWriter writer(outFile);
+
+    vector<Node*> stack;
+    while (node != nullptr || !stack.empty()) {
+        while (node != nullptr) {
+            stack.push_back(node);
+            node = node->left;
+        }
+        node = stack.back();
+        stack.pop_back();
+        if (HasValue::value) {
+            outFile << node->data;
+            ValueCodec<Value>::writeText(outFile, *node->get());
+            outFile << '\n';
+        }
+        else {
+            writer.put(node->data);
+        }
+        node = node->right;
+    }
+    writer.flush();
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+void BasicBST<Key, Compare, Allocator, Value>::serialize(Node* node, ofstream& outFile) {
+    // Inorder daje rosnacy ciag bez duplikatow, wiec kodek moze zapisac go roznicowo
+    // (dla int roznice jako varint zajmuja najczesciej 1-2 bajty).
+    typename Codec::BinaryWriter writer(outFile);
+    Node* start = node;
+
+    vector<Node*> stack;
+    while (node != nullptr || !stack.empty()) {
+        while (node != nullptr) {
+            stack.push_back(node);
+            node = node->left;
+        }
+        node = stack.back();
+        stack.pop_back();
+        writer.put(node->data);
+        node = node->right;
+    }
+    writer.flush();
+    if (!HasValue::value) {
+        return;
+    }
+
+    // Sekcja wartosci, w tej samej kolejnosci co klucze
+    node = start;
+    while (node != nullptr || !stack.empty()) {
+        while (node != nullptr) {
+            stack.push_back(node);
+            node = node->left;
+        }
+        node = stack.back();
+        stack.pop_back();
+        ValueCodec<Value>::writeBinary(outFile, *node->get());
+        node = node->right;
+    }
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+bool BasicBST<Key, Compare, Allocator, Value>::deserialize(ifstream& inFile, unsigned long long count, unsigned threads) {
+    vector<Key> keys;
+    if (!Codec::readBinary(inFile, count, comp, keys)) {
+        return false; // Plik jest uciety lub uszkodzony
+    }
+    if (!HasValue::value) {
+        clear();
+        root = buildBalanced(keys.data(), keys.size(), threads);
+        nodeCount = keys.size();
+        return true;
+    }
+
+    vector<Value> values(keys.size());
+    for (size_t i = 0; i < values.size(); i++) {
+        if (!ValueCodec<Value>::readBinary(inFile, values[i])) {
+            return false;
+        }
+    }
+
+    clear();
+    root = buildBalanced(keys.size(), threads, [&keys, &values](void* memory, size_t i) {
+        return new (memory) Node(keys[i], move(values[i]));
+    });
+    nodeCount = keys.size();
+    return true;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+typename BasicBST<Key, Compare, Allocator, Value>::Node* BasicBST<Key, Compare, Allocator, Value>::deserializeLegacy(ifstream& inFile) {
+    static_assert(is_trivially_copyable<Key>::value, "Stary format binarny wymaga trywialnie kopiowalnego typu klucza");
+    Node* result = nullptr;
+    // Stos "slotow" (wskaznikow na dzieci), ktore trzeba wypelnic w kolejnosci Preorder
+    vector<Node**> slots;
+    // Wezly w kolejnosci Preorder - odwrocona kolejnosc pozwala policzyc wysokosci od lisci
+    vector<Node*> created;
+    slots.push_back(&result);
+
+    while (!slots.empty()) {
+        Node** slot = slots.back();
+        slots.pop_back();
+
+        bool marker;
+        inFile.read(reinterpret_cast<char*>(&marker), sizeof(bool));
+        // Jesli odczyt sie nie powiodl (np. koniec pliku) lub marker to false
+        if (!inFile || !marker) {
+            continue;
+        }
+
+        Key data;
+        inFile.read(reinterpret_cast<char*>(&data), sizeof(Key));
+        if (!inFile) {
+            continue;
+        }
+
+        Node* node = createNode(data);
+        *slot = node;
+        created.push_back(node);
+        slots.push_back(&node->right);
+        slots.push_back(&node->left);
+    }
+
+    for (size_t i = created.size(); i > 0; --i) {
+        Node* node = created[i - 1];
+        updateNode(node);
+        if (node->left != nullptr) node->left->parent = node;
+        if (node->right != nullptr) node->right->parent = node;
+    }
+    nodeCount = created.size();
+    return result;
+}
+
+
+// --- Publiczne metody (wrappery) ---
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+void BasicBST<Key, Compare, Allocator, Value>::insert(KeyArg data) {
+    Node** link = locate(data);
+    if (*link != nullptr) {
+        return; // Brak duplikatow
+    }
+    attach(link, createNode(data));
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+template <typename... Args>
+pair<Value*, bool> BasicBST<Key, Compare, Allocator, Value>::emplace(KeyArg data, Args&&... args) {
+    Node** link = locate(data);
+    if (*link != nullptr) {
+        return make_pair((*link)->get(), false);
+    }
+    // Rotacje nie przenosza wezlow w pamieci, wiec wskaznik pozostaje wazny po retrace
+    Node* node = createNode(data, forward<Args>(args)...);
+    attach(link, node);
+    return make_pair(node->get(), true);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+template <typename V>
+bool BasicBST<Key, Compare, Allocator, Value>::insertOrAssign(KeyArg data, V&& value) {
+    Node** link = locate(data);
+    if (*link != nullptr) {
+        *(*link)->get() = forward<V>(value);
+        return false;
+    }
+    attach(link, createNode(data, forward<V>(value)));
+    return true;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+Value* BasicBST<Key, Compare, Allocator, Value>::find(KeyArg data) {
+    return const_cast<Value*>(static_cast<const BasicBST&>(*this).find(data));
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+const Value* BasicBST<Key, Compare, Allocator, Value>::find(KeyArg data) const {
+    size_t steps = 0; // Bez BST_STATS licznik jest nieuzywany i znika
+    Node* node = root;
+    while (node != nullptr) {
+        steps++;
+        bool goLeft;
+        if (matches(data, node->data, goLeft)) {
+            counters.lookup(steps);
+            return node->get();
+        }
+        node = goLeft ? node->left : node->right;
+    }
+    counters.lookup(steps);
+    return nullptr;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+void BasicBST<Key, Compare, Allocator, Value>::bulkLoad(vector<Key> keys, unsigned threads) {
+    if (HasValue::value) {
+        // Nowe klucze dostaja wartosci domyslne, istniejace zachowuja swoje
+        vector<pair<Key, Value>> entries;
+        entries.reserve(keys.size());
+        for (size_t i = 0; i < keys.size(); i++) {
+            entries.emplace_back(move(keys[i]), Value());
+        }
+        bulkLoad(move(entries), threads);
+        return;
+    }
+
+    threads = ParallelTasks::resolveThreads(threads);
+    if (!is_sorted(keys.begin(), keys.end(), comp)) {
+        parallelSort(keys, threads, comp, false);
+    }
+    const Compare& order = comp;
+    keys.erase(unique(keys.begin(), keys.end(), [&order](const Key& a, const Key& b) {
+        return !order(a, b) && !order(b, a);
+    }), keys.end());
+
+    if (root != nullptr) {
+        // Scalamy nowe wartosci z obecna zawartoscia drzewa (obie listy sa posortowane)
+        vector<Key> existing;
+        collectInorder(root, existing);
+        vector<Key> merged;
+        merged.reserve(existing.size() + keys.size());
+        set_union(existing.begin(), existing.end(), keys.begin(), keys.end(), back_inserter(merged), comp);
+        keys.swap(merged);
+    }
+
+    clear();
+    root = buildBalanced(keys.data(), keys.size(), threads);
+    nodeCount = keys.size();
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+void BasicBST<Key, Compare, Allocator, Value>::bulkLoad(vector<pair<Key, Value>> entries, unsigned threads) {
+    threads = ParallelTasks::resolveThreads(threads);
+    const Compare& order = comp;
+    auto keyLess = [&order](const pair<Key, Value>& a, const pair<Key, Value>& b) {
+        return order(a.first, b.first);
+    };
+    if (!is_sorted(entries.begin(), entries.end(), keyLess)) {
+        // Sortowanie stabilne, aby z powtorzen zostalo pierwsze wystapienie
+        parallelSort(entries, threads, keyLess, true);
+    }
+    entries.erase(unique(entries.begin(), entries.end(), [&order](const pair<Key, Value>& a, const pair<Key, Value>& b) {
+        return !order(a.first, b.first) && !order(b.first, a.first);
+    }), entries.end());
+
+    if (root != nullptr) {
+        // Przy rownych kluczach set_union bierze element z pierwszego ciagu - wartosci z drzewa wygrywaja
+        vector<pair<Key, Value>> existing;
+        existing.reserve(nodeCount);
+        moveEntriesOut(existing);
+        vector<pair<Key, Value>> merged;
+        merged.reserve(existing.size() + entries.size());
+        set_union(make_move_iterator(existing.begin()), make_move_iterator(existing.end()),
+            make_move_iterator(entries.begin()), make_move_iterator(entries.end()), back_inserter(merged), keyLess);
+        entries.swap(merged);
+    }
+
+    clear();
+    root = buildBalanced(entries.size(), threads, [&entries](void* memory, size_t i) {
+        return new (memory) Node(entries[i].first, move(entries[i].second));
+    });
+    nodeCount = entries.size();
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+void BasicBST<Key, Compare, Allocator, Value>::insertBatch(vector<Key> keys, unsigned threads, BatchMode mode) {
+    threads = ParallelTasks::resolveThreads(threads);
+    if (!is_sorted(keys.begin(), keys.end(), comp)) {
+        parallelSort(keys, threads, comp, false);
+    }
+    if (preferRebuild(keys.size(), mode)) {
+        bulkLoad(move(keys), threads); // Wsad jest juz posortowany
+        return;
+    }
+    for (size_t i = 0; i < keys.size(); i++) {
+        insert(keys[i]);
+    }
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+void BasicBST<Key, Compare, Allocator, Value>::removeBatch(vector<Key> keys, unsigned threads, BatchMode mode) {
+    if (root == nullptr) {
+        return;
+    }
+    threads = ParallelTasks::resolveThreads(threads);
+    if (!is_sorted(keys.begin(), keys.end(), comp)) {
+        parallelSort(keys, threads, comp, false);
+    }
+    if (!preferRebuild(keys.size(), mode)) {
+        for (size_t i = 0; i < keys.size(); i++) {
+            remove(keys[i]);
+        }
+        return;
+    }
+
+    if (!HasValue::value) {
+        vector<Key> existing;
+        existing.reserve(nodeCount);
+        collectInorder(root, existing);
+        vector<Key> remaining;
+        remaining.reserve(existing.size());
+        set_difference(existing.begin(), existing.end(), keys.begin(), keys.end(), back_inserter(remaining), comp);
+        clear();
+        root = buildBalanced(remaining.data(), remaining.size(), threads);
+        nodeCount = remaining.size();
+        return;
+    }
+
+    // Tryb slownika: wartosci zostajacych kluczy przenosimy w miejscu
+    vector<pair<Key, Value>> entries;
+    entries.reserve(nodeCount);
+    moveEntriesOut(entries);
+    size_t kept = 0;
+    size_t next = 0;
+    for (size_t i = 0; i < entries.size(); i++) {
+        while (next < keys.size() && comp(keys[next], entries[i].first)) {
+            next++;
+        }
+        if (next < keys.size() && !comp(entries[i].first, keys[next])) {
+            continue; // Klucz jest we wsadzie
+        }
+        if (kept != i) {
+            entries[kept] = move(entries[i]);
+        }
+        kept++;
+    }
+    entries.erase(entries.begin() + kept, entries.end());
+    clear();
+    root = buildBalanced(entries.size(), threads, [&entries](void* memory, size_t i) {
+        return new (memory) Node(entries[i].first, move(entries[i].second));
+    });
+    nodeCount = entries.size();
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+void BasicBST<Key, Compare, Allocator, Value>::remove(KeyArg data) {
+    Node** link = locate(data);
+    if (*link == nullptr) {
+        return; // Brak elementu
+    }
+
+    Node* node = *link;
+    if (node->left != nullptr && node->right != nullptr) {
+        // Dwoje dzieci: przenosimy klucz i wartosc nastepnika (najmniejszy w prawym poddrzewie)
+        // i usuwamy nastepnika, ktory ma co najwyzej jedno (prawe) dziecko
+        path.push_back(link);
+        Node** successor = &node->right;
+        while ((*successor)->left != nullptr) {
+            path.push_back(successor);
+            successor = &(*successor)->left;
+        }
+        node->data = move((*successor)->data);
+        *node->get() = move(*(*successor)->get());
+        link = successor;
+        node = *successor;
+    }
+
+    // Brak dziecka lub jedno dziecko
+    Node* child = (node->left != nullptr) ? node->left : node->right;
+    if (child != nullptr) child->parent = node->parent;
+    *link = child;
+    destroyNode(node);
+    nodeCount--;
+    counters.removal();
+    resize(-1);
+    retrace(path.size());
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+void BasicBST<Key, Compare, Allocator, Value>::clear() {
+    destroyKeys();
+    pool.reset();
+    root = nullptr;
+    nodeCount = 0;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+vector<Key> BasicBST<Key, Compare, Allocator, Value>::findPath(KeyArg data) const {
+    vector<Key> path;
+    findPath(data, path);
+    return path;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+bool BasicBST<Key, Compare, Allocator, Value>::findPath(KeyArg data, vector<Key>& path) const {
+    // Wysokosc ogranicza dlugosc sciezki, wiec wystarcza jedno dopasowanie rozmiaru
+    path.resize(static_cast<size_t>(height(root)));
+    path.resize(findPath(data, path.data(), path.size()));
+    return !path.empty();
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+size_t BasicBST<Key, Compare, Allocator, Value>::findPath(KeyArg data, Key* out, size_t capacity) const {
+    size_t depth = 0;
+    Node* node = root;
+    while (node != nullptr) {
+        if (depth < capacity) {
+            out[depth] = node->data;
+        }
+        depth++;
+        bool goLeft;
+        if (matches(data, node->data, goLeft)) {
+            counters.lookup(depth);
+            return depth;
+        }
+        node = goLeft ? node->left : node->right;
+    }
+    counters.lookup(depth);
+    return 0; // Nie znaleziono elementu - sciezka nie ma sensu
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+size_t BasicBST<Key, Compare, Allocator, Value>::findDepth(KeyArg data) const {
+    size_t depth = 0;
+    Node* node = root;
+    while (node != nullptr) {
+        depth++;
+        bool goLeft;
+        if (matches(data, node->data, goLeft)) {
+            counters.lookup(depth);
+            return depth;
+        }
+        node = goLeft ? node->left : node->right;
+    }
+    counters.lookup(depth);
+    return 0;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+bool BasicBST<Key, Compare, Allocator, Value>::contains(KeyArg data) const {
+    size_t steps = 0; // Bez BST_STATS licznik jest nieuzywany i znika
+    Node* node = root;
+    while (node != nullptr) {
+        steps++;
+        bool goLeft;
+        if (matches(data, node->data, goLeft)) {
+            counters.lookup(steps);
+            return true;
+        }
+        node = goLeft ? node->left : node->right;
+    }
+    counters.lookup(steps);
+    return false;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+const Key* BasicBST<Key, Compare, Allocator, Value>::select(size_t k) const {
+    Node* node = root;
+    while (node != nullptr) {
+        size_t leftSize = subtreeSize(node->left);
+        if (k == leftSize) {
+            return &node->data;
+        }
+        if (k < leftSize) {
+            node = node->left;
+        }
+        else {
+            k -= leftSize + 1;
+            node = node->right;
+        }
+    }
+    return nullptr; // k >= liczba wezlow
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+size_t BasicBST<Key, Compare, Allocator, Value>::rank(KeyArg data) const {
+    return countBelow(data, false);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+size_t BasicBST<Key, Compare, Allocator, Value>::countRange(KeyArg low, KeyArg high) const {
+    if (comp(high, low)) {
+        return 0;
+    }
+    return countBelow(high, true) - countBelow(low, false);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+typename BasicBST<Key, Compare, Allocator, Value>::Iterator& BasicBST<Key, Compare, Allocator, Value>::Iterator::operator++() {
+    if (node->right != nullptr) {
+        node = leftmost(node->right);
+        return *this;
+    }
+    // Wracamy w gore, dopoki przychodzimy z prawego poddrzewa
+    Node* child = node;
+    node = node->parent;
+    while (node != nullptr && child == node->right) {
+        child = node;
+        node = node->parent;
+    }
+    return *this;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+typename BasicBST<Key, Compare, Allocator, Value>::Iterator& BasicBST<Key, Compare, Allocator, Value>::Iterator::operator--() {
+    if (node == nullptr) {
+        node = rightmost(tree->root);
+        return *this;
+    }
+    if (node->left != nullptr) {
+        node = rightmost(node->left);
+        return *this;
+    }
+    // Wracamy w gore, dopoki przychodzimy z lewego poddrzewa
+    Node* child = node;
+    node = node->parent;
+    while (node != nullptr && child == node->left) {
+        child = node;
+        node = node->parent;
+    }
+    return *this;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+typename BasicBST<Key, Compare, Allocator, Value>::Iterator BasicBST<Key, Compare, Allocator, Value>::begin() const {
+    return Iterator(root != nullptr ? leftmost(root) : nullptr, this);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+typename BasicBST<Key, Compare, Allocator, Value>::Iterator BasicBST<Key, Compare, Allocator, Value>::end() const {
+    return Iterator(nullptr, this);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+typename BasicBST<Key, Compare, Allocator, Value>::Iterator BasicBST<Key, Compare, Allocator, Value>::lowerBound(KeyArg data) const {
+    return Iterator(firstNotBelow(data, false), this);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+typename BasicBST<Key, Compare, Allocator, Value>::Iterator BasicBST<Key, Compare, Allocator, Value>::upperBound(KeyArg data) const {
+    return Iterator(firstNotBelow(data, true), this);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+pair<typename BasicBST<Key, Compare, Allocator, Value>::Iterator, typename BasicBST<Key, Compare, Allocator, Value>::Iterator> BasicBST<Key, Compare, Allocator, Value>::equalRange(KeyArg data) const {
+    Iterator first = lowerBound(data);
+    // Klucze sa unikalne, wiec przedzial ma co najwyzej jeden element
+    Iterator last = first;
+    if (last != end() && !comp(data, *last)) {
+        ++last;
+    }
+    return make_pair(first, last);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+FrozenBST BasicBST<Key, Compare, Allocator, Value>::freeze() const {
+    static_assert(is_same<Key, int>::value && is_same<Compare, less<int>>::value,
+        "FrozenBST przechowuje tylko klucze int w porzadku rosnacym");
+    vector<Key> sorted;
+    sorted.reserve(nodeCount);
+    collectInorder(root, sorted);
+    return FrozenBST(sorted);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+int BasicBST<Key, Compare, Allocator, Value>::getHeight() const {
+    return height(root);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+size_t BasicBST<Key, Compare, Allocator, Value>::getSize() const {
+    return nodeCount;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+bool BasicBST<Key, Compare, Allocator, Value>::isBalanced() const {
+    return balanced;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+TreeStats BasicBST<Key, Compare, Allocator, Value>::getStats() const {
+    TreeStats stats;
+    counters.fill(stats);
+    stats.nodeCount = nodeCount;
+    stats.height = height(root);
+    stats.bytesUsed = nodeCount * pool.getBlockSize();
+    stats.bytesReserved = pool.bytesReserved();
+    return stats;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+void BasicBST<Key, Compare, Allocator, Value>::resetStats() {
+    counters.reset();
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+void BasicBST<Key, Compare, Allocator, Value>::display() {
+    if (root == nullptr) {
+        cout << "Drzewo jest puste." << endl;
+        return;
+    }
+
+    int choice;
+    cout << "\n--- Wybierz metode wyswietlania ---\n";
+    cout << "1. Preorder (Korzen, Lewo, Prawo)\n";
+    cout << "2. Inorder (Lewo, Korzen, Prawo)\n";
+    cout << "3. Postorder (Lewo, Prawo, Korzen)\n";
+    cout << "4. Graficznie (orientacja pozioma)\n";
+    cout << "Wybór: ";
+    cin >> choice;
+
+    switch (choice) {
+    case 1:
+        cout << "Preorder: ";
+        printPreorder(root);
+        break;
+    case 2:
+        cout << "Inorder: ";
+        printInorder(root);
+        break;
+    case 3:
+        cout << "Postorder: ";
+        printPostorder(root);
+        break;
+    case 4:
+        cout << "Drzewo (obrocone o 90 stopni w lewo):\n";
+        printGraphical(root, 0, 10);
+        break;
+    default:
+        cout << "Nieprawidlowy wybor." << endl;
+        break;
+    }
+    cout << endl;
+}
@@ -0,0 +1,368 @@
+/**
+ * @file Benchmark.cpp
+ * @brief Program porownujacy wydajnosc wyszukiwania w drzewie BST, jego zamrozonej kopii (FrozenBST),
+ * operacji wsadowych oraz skalowanie odczytow i zapisow wspolbieznych (ConcurrentBST, ShardedBST).
+ * * Uzycie: Benchmark [liczba_elementow] [liczba_zapytan]
+ * albo: Benchmark suite [maks_kluczy] [plik.csv] - pelny zestaw testow (BenchmarkSuite.h).
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+
+#include "BST.h"
+#include "BenchmarkSuite.h"
+#include "FrozenBST.h"
+#include "ConcurrentBST.h"
+#include "ShardedBST.h"
+
+using namespace std;
+
+/**
+ * @brief Wypisuje wynik pojedynczego pomiaru.
+ * @param name Nazwa mierzonej operacji.
+ * @param nanoseconds Calkowity czas pomiaru.
+ * @param queryCount Liczba wykonanych zapytan.
+ * @param checksum Suma kontrolna wynikow (wypisywana, aby kompilator nie usunal obliczen).
+ */
+void report(const string& name, long long nanoseconds, size_t queryCount, size_t checksum) {
+    cout << left << setw(28) << name << right << setw(10) << fixed << setprecision(1)
+        << static_cast<double>(nanoseconds) / queryCount << " ns/zapytanie"
+        << "   (suma kontrolna " << checksum << ")\n";
+}
+
+/**
+ * @brief Mierzy czas wykonania zapytan zadawanych pojedynczo.
+ * @param name Nazwa mierzonej operacji.
+ * @param queries Wartosci, o ktore pytamy.
+ * @param query Funkcja wykonujaca jedno zapytanie; zwraca liczbe dodawana do sumy kontrolnej.
+ */
+template <typename Query>
+void measure(const string& name, const vector<int>& queries, Query query) {
+    size_t checksum = 0;
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < queries.size(); i++) {
+        checksum += query(queries[i]);
+    }
+    auto elapsed = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+    report(name, elapsed, queries.size(), checksum);
+}
+
+/**
+ * @brief Mierzy czas wykonania zapytan zadanych jednym wywolaniem wsadowym.
+ * @param name Nazwa mierzonej operacji.
+ * @param queries Wartosci, o ktore pytamy.
+ * @param batch Funkcja wypelniajaca tablice wynikow (bool) dla wszystkich zapytan.
+ */
+template <typename Batch>
+void measureBatch(const string& name, const vector<int>& queries, Batch batch) {
+    unique_ptr<bool[]> found(new bool[queries.size()]);
+    auto start = chrono::steady_clock::now();
+    batch(queries.data(), queries.size(), found.get());
+    auto elapsed = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+
+    size_t checksum = 0;
+    for (size_t i = 0; i < queries.size(); i++) {
+        checksum += found[i] ? 1 : 0;
+    }
+    report(name, elapsed, queries.size(), checksum);
+}
+
+/**
+ * @brief Mierzy przepustowosc odczytow ConcurrentBST przy rosnacej liczbie watkow czytelnikow.
+ * * Przez caly pomiar jeden watek pisarza na zmiane dodaje i usuwa elementy.
+ * @param keys Poczatkowa zawartosc drzewa.
+ * @param queries Wartosci, o ktore pytaja czytelnicy.
+ */
+void measureConcurrentReaders(const vector<int>& keys, const vector<int>& queries) {
+    ConcurrentBST tree;
+    for (size_t i = 0; i < keys.size(); i++) {
+        tree.insert(keys[i]);
+    }
+
+    unsigned maxThreads = max(1u, thread::hardware_concurrency());
+    cout << "\nConcurrentBST: odczyty rownolegle z aktywnym pisarzem (" << maxThreads << " rdzeni)\n";
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+        atomic<bool> stop(false);
+        atomic<size_t> total(0);
+        atomic<size_t> found(0);
+
+        thread writer([&]() {
+            mt19937 generator(777);
+            while (!stop.load()) {
+                int key = static_cast<int>(generator() % (keys.size() * 2 + 1));
+                tree.insert(key);
+                tree.remove(key);
+            }
+        });
+        vector<thread> readers;
+        for (unsigned t = 0; t < threads; t++) {
+            readers.emplace_back([&, t]() {
+                size_t done = 0;
+                size_t hits = 0;
+                size_t start = t * 7919; // Kazdy watek zaczyna w innym miejscu listy zapytan
+                while (!stop.load(memory_order_relaxed)) {
+                    hits += tree.contains(queries[(start + done) % queries.size()]) ? 1 : 0;
+                    done++;
+                }
+                total += done;
+                found += hits;
+            });
+        }
+
+        this_thread::sleep_for(chrono::milliseconds(300));
+        stop.store(true);
+        writer.join();
+        for (size_t t = 0; t < readers.size(); t++) {
+            readers[t].join();
+        }
+        cout << "  watkow: " << setw(3) << threads << "   " << fixed << setprecision(2)
+            << total.load() / 0.3 / 1e6 << " mln odczytow/s   (trafien " << found.load() << ")\n";
+    }
+}
+
+/**
+ * @brief Test obciazeniowy pisarzy: kazdy watek wstawia swoj zakres kluczy, a potem usuwa
+ * z niego wartosci nieparzyste. Na koniec sprawdzana jest zawartosc drzewa.
+ * @param tree Puste drzewo (ConcurrentBST lub ShardedBST).
+ * @param threads Liczba watkow pisarzy.
+ * @param perThread Liczba kluczy w zakresie jednego watku.
+ * @return Liczba milionow operacji na sekunde albo -1, jesli zawartosc drzewa jest bledna.
+ */
+template <typename Tree>
+double runConcurrentWriters(Tree& tree, unsigned threads, int perThread) {
+    vector<thread> writers;
+    auto start = chrono::steady_clock::now();
+    for (unsigned t = 0; t < threads; t++) {
+        writers.emplace_back([&tree, t, perThread]() {
+            int first = static_cast<int>(t) * perThread;
+            vector<int> own(perThread);
+            for (int i = 0; i < perThread; i++) {
+                own[i] = first + i;
+            }
+            shuffle(own.begin(), own.end(), mt19937(t + 1));
+            for (int i = 0; i < perThread; i++) {
+                tree.insert(own[i]);
+            }
+            for (int i = 0; i < perThread; i++) {
+                if (own[i] % 2 != 0) {
+                    tree.remove(own[i]);
+                }
+            }
+        });
+    }
+    for (size_t t = 0; t < writers.size(); t++) {
+        writers[t].join();
+    }
+    auto elapsed = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+
+    int total = static_cast<int>(threads) * perThread;
+    if (tree.getSize() != static_cast<size_t>(total - total / 2)) {
+        return -1;
+    }
+    for (int key = 0; key < total; key++) {
+        if (tree.contains(key) != (key % 2 == 0)) {
+            return -1;
+        }
+    }
+    double operations = static_cast<double>(perThread) * threads * 1.5;
+    return operations / elapsed * 1e3;
+}
+
+/**
+ * @brief Porownuje przepustowosc rownoleglych pisarzy przy jednej blokadzie (ConcurrentBST)
+ * i przy blokadach zakresow (ShardedBST).
+ * @param elements Laczna liczba kluczy wstawianych przez wszystkie watki.
+ */
+void measureConcurrentWriters(size_t elements) {
+    unsigned maxThreads = max(1u, thread::hardware_concurrency());
+    cout << "\nPisarze rownolegli na rozlacznych zakresach (mln operacji/s)\n";
+    cout << "  watkow    ConcurrentBST    ShardedBST\n";
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+        int perThread = static_cast<int>(max<size_t>(1, elements / threads));
+
+        ConcurrentBST single;
+        double singleRate = runConcurrentWriters(single, threads, perThread);
+
+        ShardedBST sharded(ShardedBST::evenSplit(0, static_cast<int>(threads) * perThread - 1, threads));
+        double shardedRate = runConcurrentWriters(sharded, threads, perThread);
+
+        cout << "  " << setw(6) << threads << fixed << setprecision(2);
+        if (singleRate < 0 || shardedRate < 0) {
+            cout << "   BLAD: niepoprawna zawartosc drzewa po tescie\n";
+            continue;
+        }
+        cout << setw(17) << singleRate << setw(14) << shardedRate << "\n";
+    }
+}
+
+/**
+ * @brief Mierzy czas jednej operacji wsadowej na swiezej kopii drzewa.
+ * @param keys Klucze drzewa poczatkowego.
+ * @param batch Wsad kluczy.
+ * @param insert true dla insertBatch, false dla removeBatch.
+ * @param mode Sposob wykonania wsadu.
+ * @return Czas w milisekundach.
+ */
+double timeBatch(const vector<int>& keys, const vector<int>& batch, bool insert, BatchMode mode) {
+    BST tree;
+    tree.bulkLoad(keys);
+    auto start = chrono::steady_clock::now();
+    if (insert) {
+        tree.insertBatch(batch, 1, mode);
+    }
+    else {
+        tree.removeBatch(batch, 1, mode);
+    }
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Porownuje wykonanie wsadow kolejnymi operacjami i przebudowa drzewa dla rosnacych
+ * rozmiarow wsadu (takze przy wstawianiu do pustego drzewa), pokazujac punkt, od ktorego
+ * przebudowa jest szybsza.
+ * @param keys Klucze drzewa poczatkowego.
+ */
+void measureBatchCrossover(const vector<int>& keys) {
+    mt19937 generator(54321);
+    uniform_int_distribution<int> distribution(0, static_cast<int>(keys.size() * 2));
+
+    cout << "\nOperacje wsadowe na drzewie " << keys.size() << " elementow (ms, 1 watek)\n";
+    cout << "              insertBatch                     removeBatch\n";
+    cout << "       wsad   kolejno  przebudowa    Auto   kolejno  przebudowa    Auto\n";
+    const size_t divisors[] = { 1000, 300, 100, 30, 10, 3, 1 };
+    const BatchMode modes[] = { BatchMode::Incremental, BatchMode::Rebuild, BatchMode::Auto };
+    for (size_t divisor : divisors) {
+        size_t batchSize = max<size_t>(1, keys.size() / divisor);
+        vector<int> inserted(batchSize);
+        vector<int> removed(batchSize);
+        for (size_t i = 0; i < batchSize; i++) {
+            inserted[i] = distribution(generator);
+            removed[i] = keys[generator() % keys.size()]; // Usuwamy istniejace klucze
+        }
+
+        cout << setw(11) << batchSize << fixed << setprecision(1);
+        for (BatchMode mode : modes) {
+            cout << setw(mode == BatchMode::Rebuild ? 12 : 10) << timeBatch(keys, inserted, true, mode);
+        }
+        for (BatchMode mode : modes) {
+            cout << setw(mode == BatchMode::Rebuild ? 12 : 10) << timeBatch(keys, removed, false, mode);
+        }
+        cout << "\n";
+    }
+
+    // Glowny przypadek ladowania danych: duze wsady do pustego drzewa
+    cout << "\ninsertBatch do pustego drzewa (ms, 1 watek)\n";
+    cout << "       wsad   kolejno  przebudowa    Auto\n";
+    const vector<int> empty;
+    for (size_t divisor : { 100, 10, 1 }) {
+        size_t batchSize = max<size_t>(1, keys.size() / divisor);
+        vector<int> inserted(batchSize);
+        for (int& value : inserted) {
+            value = distribution(generator);
+        }
+        cout << setw(11) << batchSize;
+        for (BatchMode mode : modes) {
+            cout << setw(mode == BatchMode::Rebuild ? 12 : 10) << timeBatch(empty, inserted, true, mode);
+        }
+        cout << "\n";
+    }
+}
+
+/**
+ * @brief Sprawdza, ze powtarzane przebudowy drzewa tej samej wielkosci nie rezerwuja coraz wiecej pamieci.
+ * * Kazda runda dodaje i usuwa ten sam wsad przez przebudowe (BatchMode::Rebuild); pula
+ * wezlow powinna ponownie wykorzystac slaby z poprzednich rund.
+ * @param keys Klucze drzewa poczatkowego.
+ */
+void checkRebuildMemory(const vector<int>& keys) {
+    const int rounds = 20;
+    mt19937 generator(777);
+    BST tree;
+    tree.bulkLoad(keys);
+    vector<int> batch(max<size_t>(1, keys.size() / 4));
+
+    size_t firstRound = 0;
+    for (int round = 0; round < rounds; round++) {
+        for (size_t i = 0; i < batch.size(); i++) {
+            batch[i] = static_cast<int>(generator());
+        }
+        tree.insertBatch(batch, 1, BatchMode::Rebuild);
+        tree.removeBatch(batch, 1, BatchMode::Rebuild);
+        if (round == 0) {
+            firstRound = tree.getStats().bytesReserved;
+        }
+    }
+    size_t lastRound = tree.getStats().bytesReserved;
+
+    cout << "\nPamiec puli po " << rounds << " przebudowach: " << firstRound / 1024 << " KiB po pierwszej, "
+        << lastRound / 1024 << " KiB po ostatniej";
+    // Wsady roznia sie liczba duplikatow, wiec dopuszczamy niewielki wzrost
+    cout << (lastRound <= firstRound + firstRound / 100 ? "\n" : "   BLAD: pamiec rosnie z kazda przebudowa\n");
+}
+
+/**
+ * @brief Glowna funkcja programu testu wydajnosci.
+ * @param argc Liczba argumentow.
+ * @param argv Argumenty: liczba elementow i liczba zapytan albo "suite" i parametry zestawu testow.
+ * @return 0 po pomyslnym zakonczeniu programu.
+ */
+int main(int argc, char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "suite") {
+        size_t maxKeys = (argc > 2) ? strtoul(argv[2], nullptr, 10) : 1000000;
+        string csvFile = (argc > 3) ? argv[3] : "";
+        return runBenchmarkSuite(maxKeys, csvFile) ? 0 : 1;
+    }
+
+    size_t elements = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 1000000;
+    size_t queryCount = (argc > 2) ? strtoul(argv[2], nullptr, 10) : 1000000;
+
+    mt19937 generator(12345);
+    uniform_int_distribution<int> distribution(0, static_cast<int>(elements * 2));
+
+    vector<int> keys(elements);
+    for (size_t i = 0; i < elements; i++) {
+        keys[i] = distribution(generator);
+    }
+    vector<int> queries(queryCount);
+    for (size_t i = 0; i < queryCount; i++) {
+        queries[i] = distribution(generator); // Okolo polowa trafien
+    }
+
+    BST tree;
+    for (size_t i = 0; i < elements; i++) {
+        tree.insert(keys[i]);
+    }
+    FrozenBST frozen = tree.freeze();
+
+    cout << "Elementow: " << tree.getSize() << ", wysokosc drzewa: " << tree.getHeight()
+        << ", zapytan: " << queryCount << "\n\n";
+
+    measure("BST::contains", queries, [&](int key) { return tree.contains(key) ? 1 : 0; });
+    measure("FrozenBST::contains", queries, [&](int key) { return frozen.contains(key) ? 1 : 0; });
+    measureBatch("FrozenBST::containsBatch", queries, [&](const int* keys, size_t count, bool* found) {
+        frozen.containsBatch(keys, count, found);
+    });
+    measure("BST::findPath", queries, [&](int key) { return tree.findPath(key).size(); });
+    vector<int> pathBuffer(tree.getHeight());
+    measure("BST::findPath (bufor)", queries, [&](int key) {
+        return tree.findPath(key, pathBuffer.data(), pathBuffer.size());
+    });
+    measure("BST::findDepth", queries, [&](int key) { return tree.findDepth(key); });
+    measure("FrozenBST::findPath", queries, [&](int key) { return frozen.findPath(key).size(); });
+
+    measureBatchCrossover(keys);
+    checkRebuildMemory(keys);
+    measureConcurrentReaders(keys, queries);
+    measureConcurrentWriters(elements);
+
+    return 0;
+}
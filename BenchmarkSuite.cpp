@@ -0,0 +1,432 @@
+/**
+ * @file BenchmarkSuite.cpp
+ * @brief Implementacja zestawu testow wydajnosci drzewa BST i klasy FileHandler.
+ */
+
+#include "BenchmarkSuite.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio> // Do remove (usuwanie plikow tymczasowych)
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "BST.h"
+#include "FileHandler.h"
+#include "ParallelTasks.h"
+
+using namespace std;
+
+namespace {
+    /// @brief Liczba bajtow aktualnie przydzielonych przez CountingAllocator.
+    size_t allocatedBytes = 0;
+
+    /// @brief Suma kontrolna wynikow zapytan (wypisywana, aby kompilator nie usunal obliczen).
+    size_t checksum = 0;
+
+    /**
+     * @brief Alokator zliczajacy przydzielona pamiec - dzieki niemu znamy dokladny rozmiar puli wezlow.
+     * @tparam T Typ elementow.
+     */
+    template <typename T>
+    class CountingAllocator {
+    public:
+        typedef T value_type;
+
+        CountingAllocator() {}
+
+        /// @brief Konwersja z alokatora innego typu (wymagana przy rebind).
+        template <typename U>
+        CountingAllocator(const CountingAllocator<U>&) {}
+
+        /// @brief Przydziela pamiec na count elementow i dolicza ja do licznika.
+        T* allocate(size_t count) {
+            allocatedBytes += count * sizeof(T);
+            return allocator<T>().allocate(count);
+        }
+
+        /// @brief Zwalnia pamiec i odejmuje ja od licznika.
+        void deallocate(T* pointer, size_t count) {
+            allocatedBytes -= count * sizeof(T);
+            allocator<T>().deallocate(pointer, count);
+        }
+
+        bool operator==(const CountingAllocator&) const { return true; }
+        bool operator!=(const CountingAllocator&) const { return false; }
+    };
+
+    /// @brief Drzewo kluczy int z pamiecia wezlow liczona przez CountingAllocator.
+    typedef BasicBST<int, less<int>, CountingAllocator<int>> MeasuredTree;
+
+    /**
+     * @brief Rozklad (kolejnosc) kluczy, na ktorych wykonujemy operacje.
+     */
+    enum class KeyOrder {
+        Random, ///< Losowe, jednostajnie z [0, 2n].
+        Sorted, ///< Kolejne liczby 0, 1, ..., n-1 (najgorszy przypadek dla zwyklego BST).
+        Zipfian ///< Rozklad Zipfa (theta = 0.99) - niewiele "goracych" kluczy, wiele powtorzen.
+    };
+
+    /// @brief Zwraca nazwe rozkladu do wypisania w tabeli.
+    const char* orderName(KeyOrder order) {
+        switch (order) {
+        case KeyOrder::Random: return "losowe";
+        case KeyOrder::Sorted: return "rosnace";
+        default: return "zipf";
+        }
+    }
+
+    /**
+     * @brief Generator rang o rozkladzie Zipfa (metoda Graya i in., jak w YCSB).
+     * * Losowanie dziala w czasie O(1); przygotowanie liczy sume zeta w czasie O(n).
+     */
+    class ZipfGenerator {
+    private:
+        size_t items; ///< Liczba rang.
+        double theta; ///< Skosnosc rozkladu.
+        double zetaN; ///< Suma 1/i^theta dla i = 1..items.
+        double alpha; ///< 1 / (1 - theta).
+        double eta; ///< Wspolczynnik przyblizenia dla rang powyzej 2.
+
+        /// @brief Liczy sume 1/i^theta dla i = 1..count.
+        static double zeta(size_t count, double theta) {
+            double sum = 0;
+            for (size_t i = 1; i <= count; i++) {
+                sum += 1.0 / pow(static_cast<double>(i), theta);
+            }
+            return sum;
+        }
+
+    public:
+        /**
+         * @brief Konstruktor.
+         * @param items Liczba rang (co najmniej 2).
+         * @param theta Skosnosc rozkladu (0 < theta < 1).
+         */
+        ZipfGenerator(size_t items, double theta)
+            : items(items), theta(theta), zetaN(zeta(items, theta)), alpha(1.0 / (1.0 - theta)) {
+            eta = (1.0 - pow(2.0 / static_cast<double>(items), 1.0 - theta)) / (1.0 - zeta(2, theta) / zetaN);
+        }
+
+        /**
+         * @brief Losuje range (0 - najczestsza).
+         * @param generator Zrodlo liczb losowych.
+         * @return Ranga z przedzialu [0, items).
+         */
+        size_t next(mt19937_64& generator) {
+            double u = uniform_real_distribution<double>(0.0, 1.0)(generator);
+            double uz = u * zetaN;
+            if (uz < 1.0) {
+                return 0;
+            }
+            if (uz < 1.0 + pow(0.5, theta)) {
+                return 1;
+            }
+            size_t rank = static_cast<size_t>(static_cast<double>(items) * pow(eta * u - eta + 1.0, alpha));
+            return min(rank, items - 1);
+        }
+    };
+
+    /**
+     * @brief Tworzy ciag kluczy o podanym rozkladzie.
+     * @param order Rozklad kluczy.
+     * @param count Liczba kluczy.
+     * @param generator Zrodlo liczb losowych.
+     * @return Wektor kluczy.
+     */
+    vector<int> makeKeys(KeyOrder order, size_t count, mt19937_64& generator) {
+        vector<int> keys(count);
+        unsigned long long range = static_cast<unsigned long long>(count) * 2 + 1;
+        if (order == KeyOrder::Sorted) {
+            for (size_t i = 0; i < count; i++) {
+                keys[i] = static_cast<int>(i);
+            }
+        }
+        else if (order == KeyOrder::Random) {
+            uniform_int_distribution<int> distribution(0, static_cast<int>(range - 1));
+            for (size_t i = 0; i < count; i++) {
+                keys[i] = distribution(generator);
+            }
+        }
+        else {
+            // Rangi rozpraszamy po calym zakresie, aby gorace klucze nie lezaly obok siebie w drzewie
+            ZipfGenerator zipf(max<size_t>(count, 2), 0.99);
+            for (size_t i = 0; i < count; i++) {
+                keys[i] = static_cast<int>((zipf.next(generator) * 2654435761ULL) % range);
+            }
+        }
+        return keys;
+    }
+
+    /**
+     * @brief Wynik pomiaru serii operacji.
+     */
+    struct Measurement {
+        double seconds; ///< Calkowity czas serii.
+        double percentiles[4]; ///< Opoznienia p50, p90, p99 i p99.9 w nanosekundach.
+    };
+
+    /**
+     * @brief Wykonuje count operacji, mierzac czas calej serii i opoznienia pojedynczych operacji.
+     * * Mierzona jest co sampleEvery-ta operacja (najwyzej ok. 100 tys. probek), aby odczyt
+     * zegara nie zdominowal serii; opoznienie zawiera narzut jednego odczytu zegara.
+     * @param count Liczba operacji.
+     * @param operation Funkcja (size_t indeks) -> size_t, wynik trafia do sumy kontrolnej.
+     * @return Wynik pomiaru.
+     */
+    template <typename Operation>
+    Measurement measureOperations(size_t count, Operation operation) {
+        const size_t maxSamples = 100000;
+        size_t sampleEvery = max<size_t>(1, count / maxSamples);
+        vector<uint32_t> samples;
+        samples.reserve(count / sampleEvery + 1);
+
+        size_t untilSample = 0;
+        auto start = chrono::steady_clock::now();
+        for (size_t i = 0; i < count; i++) {
+            if (untilSample > 0) {
+                untilSample--;
+                checksum += operation(i);
+                continue;
+            }
+            untilSample = sampleEvery - 1;
+            auto before = chrono::steady_clock::now();
+            checksum += operation(i);
+            auto after = chrono::steady_clock::now();
+            samples.push_back(static_cast<uint32_t>(min<long long>(UINT32_MAX,
+                chrono::duration_cast<chrono::nanoseconds>(after - before).count())));
+        }
+
+        Measurement result;
+        result.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        sort(samples.begin(), samples.end());
+        const double levels[4] = { 0.5, 0.9, 0.99, 0.999 };
+        for (int i = 0; i < 4; i++) {
+            size_t index = min(samples.size() - 1, static_cast<size_t>(levels[i] * samples.size()));
+            result.percentiles[i] = samples.empty() ? 0 : samples[index];
+        }
+        return result;
+    }
+
+    /**
+     * @brief Zapisuje wyniki do tabeli na ekranie i (opcjonalnie) do pliku CSV.
+     */
+    class Report {
+    private:
+        ofstream csv; ///< Plik CSV (zamkniety, jesli nie podano nazwy).
+
+    public:
+        /**
+         * @brief Konstruktor.
+         * @param csvFile Nazwa pliku CSV (pusta - bez zapisu).
+         */
+        explicit Report(const string& csvFile) {
+            if (!csvFile.empty()) {
+                csv.open(csvFile);
+                csv << "sekcja,rozklad,klucze,operacja,sekundy,mln_op_s,p50_ns,p90_ns,p99_ns,p999_ns,bajtow_na_klucz,mb_s\n";
+            }
+        }
+
+        /// @brief Sprawdza, czy plik CSV (jesli podany) udalo sie otworzyc i zapisac.
+        bool good() const {
+            return !csv.is_open() || csv.good();
+        }
+
+        /// @brief Wypisuje naglowek tabeli operacji na drzewie.
+        void treeHeader() {
+            cout << "\nOperacje na drzewie (opoznienia w ns, pamiec wezlow w bajtach na klucz)\n"
+                << "  rozklad     klucze  operacja  mln op/s     p50     p90     p99   p99.9  B/klucz\n";
+        }
+
+        /**
+         * @brief Dopisuje wynik serii operacji na drzewie.
+         * @param order Rozklad kluczy.
+         * @param keys Liczba kluczy (i operacji).
+         * @param operation Nazwa operacji.
+         * @param result Wynik pomiaru.
+         * @param bytesPerKey Pamiec na klucz (0 - nie dotyczy).
+         */
+        void treeRow(KeyOrder order, size_t keys, const string& operation, const Measurement& result, double bytesPerKey) {
+            double rate = keys / result.seconds / 1e6;
+            cout << "  " << left << setw(8) << orderName(order) << right << setw(10) << keys
+                << "  " << left << setw(8) << operation << right << fixed << setprecision(2) << setw(10) << rate
+                << setprecision(0);
+            for (int i = 0; i < 4; i++) {
+                cout << setw(8) << result.percentiles[i];
+            }
+            if (bytesPerKey > 0) {
+                cout << setprecision(1) << setw(9) << bytesPerKey;
+            }
+            cout << "\n";
+
+            if (csv.is_open()) {
+                csv << "drzewo," << orderName(order) << ',' << keys << ',' << operation << ',' << result.seconds << ',' << rate;
+                for (int i = 0; i < 4; i++) {
+                    csv << ',' << result.percentiles[i];
+                }
+                csv << ',' << bytesPerKey << ",\n";
+            }
+        }
+
+        /// @brief Wypisuje naglowek tabeli operacji plikowych.
+        void fileHeader() {
+            cout << "\nOperacje na plikach (klucze losowe)\n"
+                << "      klucze  operacja                    s      MB/s  mln kluczy/s  B/klucz\n";
+        }
+
+        /**
+         * @brief Dopisuje wynik jednej operacji plikowej.
+         * @param keys Liczba kluczy w pliku.
+         * @param operation Nazwa operacji.
+         * @param seconds Czas operacji.
+         * @param fileBytes Rozmiar pliku w bajtach.
+         */
+        void fileRow(size_t keys, const string& operation, double seconds, double fileBytes) {
+            double rate = keys / seconds / 1e6;
+            double megabytes = fileBytes / seconds / 1e6;
+            cout << setw(12) << keys << "  " << left << setw(22) << operation << right << fixed
+                << setprecision(4) << setw(9) << seconds << setprecision(1) << setw(10) << megabytes
+                << setprecision(2) << setw(14) << rate << setprecision(1) << setw(9) << fileBytes / keys << "\n";
+
+            if (csv.is_open()) {
+                csv << "pliki,losowe," << keys << ',' << operation << ',' << seconds << ',' << rate
+                    << ",,,,," << fileBytes / keys << ',' << megabytes << "\n";
+            }
+        }
+    };
+
+    /**
+     * @brief Mierzy insert, findPath i remove dla podanego rozkladu i liczby kluczy.
+     * @param report Miejsce zapisu wynikow.
+     * @param order Rozklad kluczy.
+     * @param count Liczba kluczy.
+     */
+    void measureTree(Report& report, KeyOrder order, size_t count) {
+        mt19937_64 generator(count * 3 + static_cast<size_t>(order));
+        vector<int> keys = makeKeys(order, count, generator);
+
+        size_t before = allocatedBytes;
+        MeasuredTree tree;
+        Measurement result = measureOperations(count, [&](size_t i) {
+            tree.insert(keys[i]);
+            return static_cast<size_t>(0);
+        });
+        double bytesPerKey = static_cast<double>(allocatedBytes - before) / max<size_t>(1, tree.getSize());
+        report.treeRow(order, count, "insert", result, bytesPerKey);
+
+        vector<int> path;
+        result = measureOperations(count, [&](size_t i) {
+            return tree.findPath(keys[i], path) ? path.size() : 0;
+        });
+        report.treeRow(order, count, "findPath", result, 0);
+
+        result = measureOperations(count, [&](size_t i) {
+            tree.remove(keys[i]);
+            return static_cast<size_t>(0);
+        });
+        report.treeRow(order, count, "remove", result, 0);
+    }
+
+    /**
+     * @brief Mierzy czas pojedynczej operacji.
+     * @param operation Funkcja () -> bool wykonujaca operacje.
+     * @param success Ustawiane na wynik operacji.
+     * @return Czas w sekundach.
+     */
+    template <typename Operation>
+    double timeOperation(Operation operation, bool& success) {
+        auto start = chrono::steady_clock::now();
+        success = operation();
+        return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+
+    /// @brief Zwraca rozmiar pliku w bajtach (0, jesli pliku nie ma).
+    double fileSize(const string& filename) {
+        ifstream file(filename, ios::binary | ios::ate);
+        return file ? static_cast<double>(file.tellg()) : 0;
+    }
+
+    /**
+     * @brief Mierzy zapis i odczyt pliku tekstowego oraz binarnego dla podanej liczby kluczy.
+     * @param report Miejsce zapisu wynikow.
+     * @param count Liczba kluczy.
+     * @return true jesli wszystkie operacje sie powiodly, a wczytane drzewa maja wlasciwy rozmiar.
+     */
+    bool measureFiles(Report& report, size_t count) {
+        const string textFile = "benchmark_suite.txt";
+        const string binaryFile = "benchmark_suite.bin";
+        mt19937_64 generator(count);
+        BST tree;
+        tree.bulkLoad(makeKeys(KeyOrder::Random, count, generator));
+        FileHandler files;
+        unsigned cores = ParallelTasks::resolveThreads(0);
+        bool ok = true;
+
+        // Zapisuje wynik operacji; odczyt musi dac drzewo tej samej wielkosci co zrodlowe
+        auto record = [&](const string& name, const string& filename, double seconds, bool success, size_t size) {
+            if (!success || size != tree.getSize()) {
+                cerr << "Blad: " << name << " dla " << count << " kluczy\n";
+                ok = false;
+                return;
+            }
+            report.fileRow(size, name, seconds, fileSize(filename));
+        };
+        bool success = false;
+        double seconds = timeOperation([&] { return files.saveToText(tree, textFile); }, success);
+        record("saveToText", textFile, seconds, success, tree.getSize());
+        BST fromText;
+        seconds = timeOperation([&] { return files.loadFromText(fromText, textFile); }, success);
+        record("loadFromText", textFile, seconds, success, fromText.getSize());
+        if (cores > 1) {
+            BST fromTextParallel;
+            seconds = timeOperation([&] { return files.loadFromText(fromTextParallel, textFile, cores); }, success);
+            record("loadFromText (" + to_string(cores) + " w.)", textFile, seconds, success, fromTextParallel.getSize());
+        }
+
+        seconds = timeOperation([&] { return files.saveToBinary(tree, binaryFile); }, success);
+        record("saveToBinary", binaryFile, seconds, success, tree.getSize());
+        BST fromBinary;
+        seconds = timeOperation([&] { return files.loadFromBinary(fromBinary, binaryFile); }, success);
+        record("loadFromBinary", binaryFile, seconds, success, fromBinary.getSize());
+        if (cores > 1) {
+            BST fromBinaryParallel;
+            seconds = timeOperation([&] { return files.loadFromBinary(fromBinaryParallel, binaryFile, cores); }, success);
+            record("loadFromBinary (" + to_string(cores) + " w.)", binaryFile, seconds, success, fromBinaryParallel.getSize());
+        }
+
+        remove(textFile.c_str());
+        remove(binaryFile.c_str());
+        return ok;
+    }
+}
+
+bool runBenchmarkSuite(size_t maxKeys, const string& csvFile) {
+    Report report(csvFile);
+    const KeyOrder orders[] = { KeyOrder::Random, KeyOrder::Sorted, KeyOrder::Zipfian };
+
+    report.treeHeader();
+    for (size_t count = 1000; count <= maxKeys; count *= 10) {
+        for (KeyOrder order : orders) {
+            measureTree(report, order, count);
+        }
+    }
+
+    bool ok = true;
+    report.fileHeader();
+    for (size_t count = 1000; count <= maxKeys; count *= 10) {
+        ok = measureFiles(report, count) && ok;
+    }
+
+    cout << "\n(suma kontrolna " << checksum << ")\n";
+    if (!report.good()) {
+        cerr << "Blad: Nie mozna zapisac wynikow do pliku: " << csvFile << endl;
+        return false;
+    }
+    return ok;
+}
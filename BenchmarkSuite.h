@@ -0,0 +1,24 @@
+/**
+ * @file BenchmarkSuite.h
+ * @brief Deklaracja zestawu testow wydajnosci drzewa BST i klasy FileHandler.
+ * * Zestaw mierzy insert/remove/findPath dla kluczy losowych, posortowanych i o rozkladzie
+ * Zipfa oraz zapis i odczyt plikow, dla rosnacej liczby kluczy (10^3, 10^4, ...).
+ * Uruchamiany z programu Benchmark: Benchmark suite [maks_kluczy] [plik.csv]
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+using namespace std;
+
+/**
+ * @brief Uruchamia caly zestaw testow i wypisuje wyniki na standardowe wyjscie.
+ * * Dla operacji na drzewie raportuje przepustowosc, percentyle opoznien (p50, p90, p99,
+ * p99.9) i pamiec wezlow na klucz; dla plikow - przepustowosc i rozmiar pliku na klucz.
+ * @param maxKeys Najwieksza liczba kluczy (rozmiary rosna dziesieciokrotnie od 1000).
+ * @param csvFile Plik, do ktorego trafiaja wyniki w formacie CSV (pusty - bez zapisu).
+ * @return true jesli testy sie powiodly, false przy bledzie zapisu lub odczytu pliku.
+ */
+bool runBenchmarkSuite(size_t maxKeys, const string& csvFile);
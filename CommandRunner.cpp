@@ -0,0 +1,247 @@
+/**
+ * @file CommandRunner.cpp
+ * @brief Implementacja metod klasy CommandRunner.
+ */
+
+#include "CommandRunner.h"
+#include "IntCodec.h"
+#include <cstring>
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+namespace {
+    /// @brief Pomija biale znaki od poczatku tekstu.
+    const char* skipSpace(const char* p, const char* end) {
+        while (p != end && IntCodec::isSpace(*p)) {
+            ++p;
+        }
+        return p;
+    }
+
+    /// @brief Zwraca koniec slowa zaczynajacego sie w p.
+    const char* wordEnd(const char* p, const char* end) {
+        while (p != end && !IntCodec::isSpace(*p)) {
+            ++p;
+        }
+        return p;
+    }
+
+    /// @brief Porownuje slowo [begin, end) z napisem.
+    bool isWord(const char* begin, const char* end, const char* word) {
+        size_t length = strlen(word);
+        return static_cast<size_t>(end - begin) == length && memcmp(begin, word, length) == 0;
+    }
+}
+
+CommandRunner::CommandRunner(BST& tree, ostream& out)
+    : tree(tree), out(out), lineNumber(0), failures(0) {
+    output.reserve(blockSize + IntCodec::maxLongChars + 1);
+}
+
+bool CommandRunner::run(istream& in) {
+    vector<char> buffer(blockSize);
+    size_t carry = 0; // Liczba bajtow niedokonczonej linii z poprzedniego bloku
+
+    while (true) {
+        in.read(buffer.data() + carry, static_cast<streamsize>(buffer.size() - carry));
+        size_t length = carry + static_cast<size_t>(in.gcount());
+        bool lastBlock = !in;
+
+        const char* begin = buffer.data();
+        const char* end = begin + length;
+        const char* line = begin;
+        while (true) {
+            const char* newline = static_cast<const char*>(memchr(line, '\n', static_cast<size_t>(end - line)));
+            if (newline == nullptr) {
+                break;
+            }
+            ++lineNumber;
+            execute(line, newline);
+            line = newline + 1;
+        }
+
+        carry = static_cast<size_t>(end - line);
+        if (lastBlock) {
+            if (carry > 0) {
+                ++lineNumber;
+                execute(line, end); // Ostatnia linia bez znaku nowej linii
+            }
+            break;
+        }
+        if (carry == buffer.size()) {
+            buffer.resize(buffer.size() * 2); // Linia dluzsza niz blok (np. bardzo dluga nazwa pliku)
+        }
+        memmove(buffer.data(), line, carry);
+    }
+
+    flush();
+    out.flush();
+    return failures == 0;
+}
+
+void CommandRunner::execute(const char* begin, const char* end) {
+    const char* command = skipSpace(begin, end);
+    if (command == end || *command == '#') {
+        return; // Pusta linia lub komentarz
+    }
+    const char* commandEnd = wordEnd(command, end);
+    const char* args = commandEnd;
+
+    if (isWord(command, commandEnd, "add")) {
+        if (!readNumbers(args, end, 1)) return;
+        tree.insert(numbers[0]);
+        write("ok", 2);
+    }
+    else if (isWord(command, commandEnd, "remove")) {
+        if (!readNumbers(args, end, 1)) return;
+        tree.remove(numbers[0]);
+        write("ok", 2);
+    }
+    else if (isWord(command, commandEnd, "find")) {
+        if (!readNumbers(args, end, 1)) return;
+        size_t depth = tree.findDepth(numbers[0]);
+        if (depth == 0) {
+            write("missing", 7);
+        }
+        else {
+            write("found ", 6);
+            write(static_cast<long long>(depth));
+        }
+    }
+    else if (isWord(command, commandEnd, "path")) {
+        if (!readNumbers(args, end, 1)) return;
+        if (!tree.findPath(numbers[0], path)) {
+            write("missing", 7);
+        }
+        else {
+            for (size_t i = 0; i < path.size(); ++i) {
+                if (i > 0) {
+                    write(" ", 1);
+                }
+                write(path[i]);
+            }
+        }
+    }
+    else if (isWord(command, commandEnd, "rank")) {
+        if (!readNumbers(args, end, 1)) return;
+        write(static_cast<long long>(tree.rank(numbers[0])));
+    }
+    else if (isWord(command, commandEnd, "select")) {
+        if (!readNumbers(args, end, 1)) return;
+        const int* found = (numbers[0] >= 0) ? tree.select(static_cast<size_t>(numbers[0])) : nullptr;
+        if (found == nullptr) {
+            write("missing", 7);
+        }
+        else {
+            write(*found);
+        }
+    }
+    else if (isWord(command, commandEnd, "count")) {
+        if (!readNumbers(args, end, 2)) return;
+        write(static_cast<long long>(tree.countRange(numbers[0], numbers[1])));
+    }
+    else if (isWord(command, commandEnd, "size")) {
+        if (!readNumbers(args, end, 0)) return;
+        write(static_cast<long long>(tree.getSize()));
+    }
+    else if (isWord(command, commandEnd, "height")) {
+        if (!readNumbers(args, end, 0)) return;
+        write(static_cast<long long>(tree.getHeight()));
+    }
+    else if (isWord(command, commandEnd, "stats")) {
+        if (!readNumbers(args, end, 0)) return;
+        string json = "{\"tree\":" + tree.getStats().toJson() + ",\"files\":" + fileHandler.getStats().toJson() + "}";
+        write(json.data(), json.size());
+    }
+    else if (isWord(command, commandEnd, "clear")) {
+        if (!readNumbers(args, end, 0)) return;
+        tree.clear();
+        write("ok", 2);
+    }
+    else if (isWord(command, commandEnd, "save") || isWord(command, commandEnd, "load")) {
+        bool save = (*command == 's');
+        const char* format = skipSpace(args, end);
+        const char* formatEnd = wordEnd(format, end);
+        bool text = isWord(format, formatEnd, "text");
+        if (!text && !isWord(format, formatEnd, "bin")) {
+            fail("oczekiwano formatu text lub bin");
+            return;
+        }
+
+        // Nazwa pliku to reszta linii bez otaczajacych bialych znakow
+        const char* name = skipSpace(formatEnd, end);
+        const char* nameEnd = end;
+        while (nameEnd != name && IntCodec::isSpace(nameEnd[-1])) {
+            --nameEnd;
+        }
+        if (name == nameEnd) {
+            fail("brak nazwy pliku");
+            return;
+        }
+        string filename(name, nameEnd);
+
+        // Komunikaty FileHandler trafiaja na cerr - wczesniejsze wyniki wypisujemy przed nimi
+        flush();
+        out.flush();
+        bool ok;
+        if (save) {
+            ok = text ? fileHandler.saveToText(tree, filename) : fileHandler.saveToBinary(tree, filename);
+        }
+        else {
+            ok = text ? fileHandler.loadFromText(tree, filename) : fileHandler.loadFromBinary(tree, filename);
+        }
+        if (!ok) {
+            fail(save ? "nie udalo sie zapisac pliku" : "nie udalo sie wczytac pliku");
+            return;
+        }
+        write("ok", 2);
+    }
+    else {
+        fail("nieznane polecenie");
+        return;
+    }
+    endLine();
+}
+
+bool CommandRunner::readNumbers(const char* begin, const char* end, size_t count) {
+    numbers.clear();
+    if (!IntCodec::parse(begin, end, numbers) || numbers.size() != count) {
+        fail(count == 0 ? "polecenie nie przyjmuje argumentow" : "niepoprawne argumenty liczbowe");
+        return false;
+    }
+    return true;
+}
+
+void CommandRunner::fail(const char* message) {
+    ++failures;
+    write("error", 5);
+    endLine();
+    flush();
+    out.flush();
+    cerr << "Blad (linia " << lineNumber << "): " << message << endl;
+}
+
+void CommandRunner::write(const char* text, size_t length) {
+    output.insert(output.end(), text, text + length);
+}
+
+void CommandRunner::write(long long value) {
+    char digits[IntCodec::maxLongChars];
+    write(digits, static_cast<size_t>(IntCodec::format(value, digits) - digits));
+}
+
+void CommandRunner::endLine() {
+    output.push_back('\n');
+    if (output.size() >= blockSize) {
+        flush();
+    }
+}
+
+void CommandRunner::flush() {
+    if (!output.empty()) {
+        out.write(output.data(), static_cast<streamsize>(output.size()));
+        output.clear();
+    }
+}
@@ -0,0 +1,103 @@
+/**
+ * @file CommandRunner.h
+ * @brief Definicja klasy CommandRunner - wsadowego (nieinteraktywnego) trybu programu.
+ * * Tryb wsadowy czyta strumien polecen (ze standardowego wejscia lub z pliku),
+ * wykonuje je bez zadnych pytan i pauz, a na kazde polecenie wypisuje dokladnie
+ * jedna linie wyniku, ktora latwo przetworzyc skryptem.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+#include "BST.h"
+#include "FileHandler.h"
+
+using namespace std;
+
+/**
+ * @brief Wykonuje polecenia tekstowe na drzewie BST.
+ * * Jedna linia to jedno polecenie; slowa oddzielane sa bialymi znakami, puste linie
+ * i linie zaczynajace sie od '#' sa pomijane. Obslugiwane polecenia i ich wyniki:
+ *   - `add K`, `remove K`, `clear` - "ok",
+ *   - `find K` - "found G" (G - glebokosc elementu, 1 dla korzenia) albo "missing",
+ *   - `path K` - klucze na sciezce od korzenia, oddzielone spacja, albo "missing",
+ *   - `rank K`, `count A B`, `size`, `height` - jedna liczba,
+ *   - `select I` - I-ty najmniejszy klucz (od 0) albo "missing",
+ *   - `stats` - statystyki drzewa i operacji plikowych jako JSON w jednej linii (patrz Stats.h),
+ *   - `save text|bin PLIK`, `load text|bin PLIK` - "ok" albo "error"
+ *     (nazwa pliku to reszta linii, moze zawierac spacje; `load text` dodaje liczby do drzewa).
+ * Nieznane lub niepoprawne polecenie daje linie "error", a opis bledu (z numerem linii)
+ * trafia na cerr; wykonanie jest kontynuowane.
+ * Wejscie jest czytane, a wyjscie zapisywane duzymi blokami, wiec narzut na polecenie
+ * jest maly w porownaniu z sama operacja na drzewie.
+ */
+class CommandRunner {
+private:
+    BST& tree; ///< Drzewo, na ktorym wykonywane sa polecenia.
+    FileHandler fileHandler; ///< Obsluga polecen save i load.
+    ostream& out; ///< Strumien wynikow.
+    vector<char> output; ///< Bufor wynikow, oprozniany do out po przekroczeniu blockSize.
+    vector<int> numbers; ///< Bufor na liczby odczytane z polecenia.
+    vector<int> path; ///< Bufor na sciezke dla polecenia path.
+    size_t lineNumber; ///< Numer aktualnie wykonywanej linii (do komunikatow bledow).
+    size_t failures; ///< Liczba polecen zakonczonych bledem.
+
+    /// @brief Rozmiar bloku wejscia i wyjscia w bajtach.
+    static const size_t blockSize = 1 << 16;
+
+    /**
+     * @brief Wykonuje jedna linie polecenia.
+     * @param begin Poczatek linii.
+     * @param end Koniec linii (bez znaku nowej linii).
+     */
+    void execute(const char* begin, const char* end);
+
+    /**
+     * @brief Odczytuje dokladnie podana liczbe argumentow liczbowych.
+     * @param begin Poczatek argumentow.
+     * @param end Koniec linii.
+     * @param count Oczekiwana liczba argumentow.
+     * @return true jesli argumenty sa poprawne (trafiaja do bufora numbers).
+     */
+    bool readNumbers(const char* begin, const char* end, size_t count);
+
+    /**
+     * @brief Zglasza bledne polecenie: wypisuje "error" i opis na cerr.
+     * @param message Opis bledu.
+     */
+    void fail(const char* message);
+
+    /// @brief Dopisuje tekst do bufora wynikow.
+    void write(const char* text, size_t length);
+
+    /// @brief Dopisuje liczbe do bufora wynikow.
+    void write(long long value);
+
+    /// @brief Konczy linie wyniku i oproznia bufor, jesli jest pelny.
+    void endLine();
+
+    /// @brief Zapisuje zawartosc bufora wynikow do strumienia.
+    void flush();
+
+public:
+    /**
+     * @brief Konstruktor.
+     * @param tree Drzewo, na ktorym beda wykonywane polecenia.
+     * @param out Strumien wynikow.
+     */
+    CommandRunner(BST& tree, ostream& out);
+
+    /**
+     * @brief Wykonuje wszystkie polecenia ze strumienia az do jego konca.
+     * @param in Strumien polecen.
+     * @return true jesli wszystkie polecenia zakonczyly sie powodzeniem.
+     */
+    bool run(istream& in);
+
+    /// @brief Zwraca liczbe polecen zakonczonych bledem.
+    size_t getFailures() const { return failures; }
+};
@@ -0,0 +1,238 @@
+/**
+ * @file ConcurrentBST.cpp
+ * @brief Implementacja metod klasy ConcurrentBST.
+ */
+
+#include "ConcurrentBST.h"
+#include <algorithm> // Do max
+
+using namespace std;
+
+ConcurrentBST::Node::Node(int data, const Node* left, const Node* right, unsigned long long version)
+    : data(data), height(1 + max(ConcurrentBST::height(left), ConcurrentBST::height(right))),
+    left(left), right(right), version(version) {}
+
+ConcurrentBST::ConcurrentBST() : root(nullptr), nodeCount(0), writeVersion(0) {}
+
+ConcurrentBST::~ConcurrentBST() {
+    vector<const Node*> stack;
+    if (root.load() != nullptr) {
+        stack.push_back(root.load());
+    }
+    while (!stack.empty()) {
+        const Node* node = stack.back();
+        stack.pop_back();
+        if (node->left != nullptr) stack.push_back(node->left);
+        if (node->right != nullptr) stack.push_back(node->right);
+        delete node;
+    }
+}
+
+// --- Prywatne metody pomocnicze ---
+
+int ConcurrentBST::height(const Node* node) {
+    return node ? node->height : 0;
+}
+
+void ConcurrentBST::destroyNode(void* node) {
+    delete static_cast<Node*>(node);
+}
+
+const ConcurrentBST::Node* ConcurrentBST::makeNode(int data, const Node* left, const Node* right) {
+    return new Node(data, left, right, writeVersion);
+}
+
+void ConcurrentBST::discard(const Node* node) {
+    if (node->version == writeVersion) {
+        delete node; // Utworzony w tej operacji - nikt go jeszcze nie widzial
+    }
+    else {
+        pending.push_back(node);
+    }
+}
+
+const ConcurrentBST::Node* ConcurrentBST::balance(int data, const Node* left, const Node* right) {
+    int leftHeight = height(left);
+    int rightHeight = height(right);
+
+    if (leftHeight > rightHeight + 1) {
+        const Node* result;
+        if (height(left->left) >= height(left->right)) {
+            // Pojedyncza rotacja w prawo
+            result = makeNode(left->data, left->left, makeNode(data, left->right, right));
+        }
+        else {
+            // Podwojna rotacja Lewo-Prawo
+            const Node* pivot = left->right;
+            result = makeNode(pivot->data, makeNode(left->data, left->left, pivot->left),
+                makeNode(data, pivot->right, right));
+            discard(pivot);
+        }
+        discard(left);
+        return result;
+    }
+    if (rightHeight > leftHeight + 1) {
+        const Node* result;
+        if (height(right->right) >= height(right->left)) {
+            // Pojedyncza rotacja w lewo
+            result = makeNode(right->data, makeNode(data, left, right->left), right->right);
+        }
+        else {
+            // Podwojna rotacja Prawo-Lewo
+            const Node* pivot = right->left;
+            result = makeNode(pivot->data, makeNode(data, left, pivot->left),
+                makeNode(right->data, pivot->right, right->right));
+            discard(pivot);
+        }
+        discard(right);
+        return result;
+    }
+    return makeNode(data, left, right);
+}
+
+const ConcurrentBST::Node* ConcurrentBST::rebuild(const vector<Step>& path, const Node* child) {
+    for (size_t i = path.size(); i > 0; --i) {
+        const Node* node = path[i - 1].node;
+        child = path[i - 1].wentRight
+            ? balance(node->data, node->left, child)
+            : balance(node->data, child, node->right);
+        discard(node);
+    }
+    return child;
+}
+
+void ConcurrentBST::publish(const Node* newRoot) {
+    root.store(newRoot);
+    // Dopiero teraz stare wezly sa niedostepne dla nowych czytelnikow
+    for (size_t i = 0; i < pending.size(); i++) {
+        epochs.retire(const_cast<Node*>(pending[i]), destroyNode);
+    }
+    pending.clear();
+}
+
+// --- Zapisy ---
+
+void ConcurrentBST::insert(int data) {
+    lock_guard<mutex> lock(writerMutex);
+    writeVersion++;
+
+    vector<Step> path;
+    const Node* node = root.load();
+    while (node != nullptr) {
+        if (data == node->data) {
+            return; // Brak duplikatow
+        }
+        bool right = data > node->data;
+        path.push_back(Step{ node, right });
+        node = right ? node->right : node->left;
+    }
+
+    publish(rebuild(path, makeNode(data, nullptr, nullptr)));
+    nodeCount++;
+}
+
+void ConcurrentBST::remove(int data) {
+    lock_guard<mutex> lock(writerMutex);
+    writeVersion++;
+
+    vector<Step> path;
+    const Node* node = root.load();
+    while (node != nullptr && node->data != data) {
+        bool right = data > node->data;
+        path.push_back(Step{ node, right });
+        node = right ? node->right : node->left;
+    }
+    if (node == nullptr) {
+        return; // Brak elementu
+    }
+
+    const Node* replacement;
+    if (node->left != nullptr && node->right != nullptr) {
+        // Dwoje dzieci: nastepnik (najmniejszy w prawym poddrzewie) zajmuje miejsce wezla
+        vector<Step> successorPath;
+        const Node* successor = node->right;
+        while (successor->left != nullptr) {
+            successorPath.push_back(Step{ successor, false });
+            successor = successor->left;
+        }
+        int successorData = successor->data;
+        const Node* newRight = rebuild(successorPath, successor->right);
+        discard(successor);
+        replacement = balance(successorData, node->left, newRight);
+    }
+    else {
+        replacement = (node->left != nullptr) ? node->left : node->right;
+    }
+    discard(node);
+
+    publish(rebuild(path, replacement));
+    nodeCount--;
+}
+
+void ConcurrentBST::clear() {
+    lock_guard<mutex> lock(writerMutex);
+    writeVersion++;
+
+    const Node* oldRoot = root.load();
+    if (oldRoot != nullptr) {
+        vector<const Node*> stack;
+        stack.push_back(oldRoot);
+        while (!stack.empty()) {
+            const Node* node = stack.back();
+            stack.pop_back();
+            if (node->left != nullptr) stack.push_back(node->left);
+            if (node->right != nullptr) stack.push_back(node->right);
+            pending.push_back(node);
+        }
+    }
+    publish(nullptr);
+    nodeCount = 0;
+}
+
+// --- Odczyty (bez blokad) ---
+
+bool ConcurrentBST::contains(int data) const {
+    EpochGuard guard(epochs);
+    const Node* node = root.load();
+    while (node != nullptr) {
+        if (data == node->data) {
+            return true;
+        }
+        node = (data < node->data) ? node->left : node->right;
+    }
+    return false;
+}
+
+vector<int> ConcurrentBST::findPath(int data) const {
+    vector<int> path;
+    EpochGuard guard(epochs);
+    const Node* node = root.load();
+    while (node != nullptr) {
+        path.push_back(node->data);
+        if (data == node->data) {
+            return path;
+        }
+        node = (data < node->data) ? node->left : node->right;
+    }
+    path.clear();
+    return path;
+}
+
+void ConcurrentBST::appendInorder(vector<int>& out) const {
+    forEachInorder([&out](int data) { out.push_back(data); });
+}
+
+FrozenBST ConcurrentBST::freeze() const {
+    vector<int> sorted;
+    appendInorder(sorted);
+    return FrozenBST(sorted);
+}
+
+size_t ConcurrentBST::getSize() const {
+    return nodeCount.load();
+}
+
+int ConcurrentBST::getHeight() const {
+    EpochGuard guard(epochs);
+    return height(root.load());
+}
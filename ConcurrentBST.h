@@ -0,0 +1,221 @@
+/**
+ * @file ConcurrentBST.h
+ * @brief Definicja klasy ConcurrentBST - drzewa AVL bezpiecznego dla wielu czytelnikow i pisarza.
+ * * Wezly opublikowane w drzewie nigdy sie nie zmieniaja. Pisarz kopiuje sciezke od
+ * zmienianego miejsca do korzenia i atomowo podmienia wskaznik korzenia, wiec
+ * czytelnicy zawsze widza spojna wersje drzewa i nigdy nie czekaja na insert/remove.
+ * Stare wezly sa zwalniane przez EpochManager, gdy zaden czytelnik ich juz nie widzi.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "EpochManager.h"
+#include "FrozenBST.h"
+
+using namespace std;
+
+/**
+ * @brief Zrownowazone drzewo BST z nieblokujacymi odczytami (kopiowanie sciezki + epoki).
+ * * Odczyty (contains, findPath, freeze, getHeight) nie zakladaja zadnych blokad.
+ * Zapisy (insert, remove, clear) sa serializowane muteksem pisarzy.
+ */
+class ConcurrentBST {
+private:
+    /**
+     * @brief Niezmienny wezel drzewa.
+     */
+    struct Node {
+        int data; ///< Wartosc przechowywana w wezle.
+        int height; ///< Wysokosc poddrzewa.
+        const Node* left; ///< Lewe dziecko.
+        const Node* right; ///< Prawe dziecko.
+        unsigned long long version; ///< Numer operacji zapisu, ktora utworzyla wezel.
+
+        /**
+         * @brief Konstruktor wezla.
+         * @param data Wartosc.
+         * @param left Lewe dziecko.
+         * @param right Prawe dziecko.
+         * @param version Numer biezacej operacji zapisu.
+         */
+        Node(int data, const Node* left, const Node* right, unsigned long long version);
+    };
+
+    atomic<const Node*> root; ///< Korzen aktualnej wersji drzewa.
+    atomic<size_t> nodeCount; ///< Liczba elementow.
+    mutable EpochManager epochs; ///< Rejestracja czytelnikow i odroczone zwalnianie wezlow.
+    mutex writerMutex; ///< Serializuje pisarzy.
+    unsigned long long writeVersion; ///< Numer biezacej operacji zapisu (chroniony writerMutex).
+    vector<const Node*> pending; ///< Opublikowane wezly porzucone w biezacej operacji, do wycofania po publikacji.
+
+    /**
+     * @brief Zwraca wysokosc poddrzewa (0 dla pustego).
+     * @param node Korzen poddrzewa.
+     * @return Wysokosc.
+     */
+    static int height(const Node* node);
+
+    /**
+     * @brief Zwalnia wezel (funkcja przekazywana do EpochManager).
+     * @param node Wezel do usuniecia.
+     */
+    static void destroyNode(void* node);
+
+    /**
+     * @brief Tworzy nowy (jeszcze nieopublikowany) wezel.
+     * @param data Wartosc.
+     * @param left Lewe dziecko.
+     * @param right Prawe dziecko.
+     * @return Nowy wezel.
+     */
+    const Node* makeNode(int data, const Node* left, const Node* right);
+
+    /**
+     * @brief Porzuca wezel zastapiony kopia.
+     * * Wezly utworzone w biezacej operacji nikt jeszcze nie widzial, wiec sa usuwane od razu;
+     * opublikowane trafiaja do EpochManager.
+     * @param node Porzucany wezel.
+     */
+    void discard(const Node* node);
+
+    /**
+     * @brief Tworzy wezel o podanej wartosci i dzieciach, w razie potrzeby wykonujac rotacje AVL.
+     * * Dzieci musza byc zrownowazone, a ich wysokosci moga sie roznic co najwyzej o 2.
+     * @param data Wartosc.
+     * @param left Lewe poddrzewo.
+     * @param right Prawe poddrzewo.
+     * @return Korzen nowego, zrownowazonego poddrzewa.
+     */
+    const Node* balance(int data, const Node* left, const Node* right);
+
+    /**
+     * @brief Element sciezki zapisywanej podczas schodzenia w dol drzewa.
+     */
+    struct Step {
+        const Node* node; ///< Odwiedzony wezel.
+        bool wentRight; ///< Czy dalej zeszlismy do prawego dziecka.
+    };
+
+    /**
+     * @brief Kopiuje sciezke od dolu do korzenia, podpinajac nowe poddrzewo.
+     * @param path Sciezka od korzenia (kazdy wezel zostanie zastapiony kopia).
+     * @param child Nowe poddrzewo w miejscu ostatniego kroku.
+     * @return Nowy korzen.
+     */
+    const Node* rebuild(const vector<Step>& path, const Node* child);
+
+    /**
+     * @brief Dopisuje wartosci jednej, spojnej wersji drzewa (rosnaco) na koniec wektora.
+     * @param out Wektor wyjsciowy.
+     */
+    void appendInorder(vector<int>& out) const;
+
+    /**
+     * @brief Publikuje nowy korzen i wycofuje porzucone wezly starej wersji (wymaga writerMutex).
+     * @param newRoot Nowy korzen.
+     */
+    void publish(const Node* newRoot);
+
+public:
+    /// @brief Konstruktor, tworzy puste drzewo.
+    ConcurrentBST();
+
+    /// @brief Destruktor, zwalnia wszystkie wezly (nie moga trwac zadne operacje).
+    ~ConcurrentBST();
+
+    ConcurrentBST(const ConcurrentBST&) = delete;
+    ConcurrentBST& operator=(const ConcurrentBST&) = delete;
+
+    /**
+     * @brief Dodaje element do drzewa.
+     * @param data Wartosc do dodania.
+     */
+    void insert(int data);
+
+    /**
+     * @brief Usuwa element z drzewa.
+     * @param data Wartosc do usuniecia.
+     */
+    void remove(int data);
+
+    /**
+     * @brief Usuwa wszystkie elementy z drzewa.
+     */
+    void clear();
+
+    /**
+     * @brief Sprawdza, czy element wystepuje w drzewie (bez blokad).
+     * @param data Szukana wartosc.
+     * @return true jesli element zostal znaleziony.
+     */
+    bool contains(int data) const;
+
+    /**
+     * @brief Wyszukuje sciezke od korzenia do elementu (bez blokad).
+     * @param data Wartosc do znalezienia.
+     * @return Wektor wartosci na sciezce; pusty, jesli elementu nie znaleziono.
+     */
+    vector<int> findPath(int data) const;
+
+    /**
+     * @brief Przekazuje wartosci jednej, spojnej wersji drzewa (z chwili wywolania) rosnaco (bez blokad).
+     * * Pisarze dzialaja w tym czasie dalej na nowych wersjach; wezly odwiedzanej wersji
+     * nie zostana zwolnione przed koncem przejscia.
+     * @param visit Funkcja wywolywana dla kazdej wartosci (int).
+     */
+    template <typename Visitor>
+    void forEachInorder(Visitor visit) const {
+        forEachInorder(visit, []() {});
+    }
+
+    /**
+     * @brief Wersja forEachInorder() z powiadomieniem o ustaleniu odwiedzanej wersji.
+     * @param visit Funkcja wywolywana dla kazdej wartosci (int).
+     * @param pinned Funkcja wywolywana raz, zaraz po odczytaniu korzenia - pozniejsze zmiany
+     * nie beda juz widoczne w przejsciu.
+     */
+    template <typename Visitor, typename Pinned>
+    void forEachInorder(Visitor visit, Pinned pinned) const {
+        EpochGuard guard(epochs);
+        vector<const Node*> stack;
+        const Node* node = root.load();
+        pinned();
+        while (node != nullptr || !stack.empty()) {
+            while (node != nullptr) {
+                stack.push_back(node);
+                node = node->left;
+            }
+            node = stack.back();
+            stack.pop_back();
+            visit(node->data);
+            node = node->right;
+        }
+    }
+
+    /**
+     * @brief Tworzy niezmienna kopie spojnej wersji drzewa z chwili wywolania (bez blokad).
+     * @return Indeks FrozenBST.
+     */
+    FrozenBST freeze() const;
+
+    /**
+     * @brief Zwraca liczbe elementow.
+     * @return Liczba elementow.
+     */
+    size_t getSize() const;
+
+    /**
+     * @brief Zwraca wysokosc aktualnej wersji drzewa.
+     * @return Liczba poziomow (0 dla pustego drzewa).
+     */
+    int getHeight() const;
+
+    /**
+     * @brief Zaprzyjaznienie klasy ShardedBST, ktora sklada wynik freeze() z wielu drzew.
+     */
+    friend class ShardedBST;
+};
@@ -0,0 +1,81 @@
+/**
+ * @file EpochManager.cpp
+ * @brief Implementacja metod klasy EpochManager.
+ */
+
+#include "EpochManager.h"
+
+using namespace std;
+
+namespace {
+    /// @brief Po tylu wycofaniach pisarz probuje zmienic epoke.
+    const size_t advanceThreshold = 256;
+}
+
+EpochManager::EpochManager() : epoch(0), retiredSinceAdvance(0) {
+    for (size_t i = 0; i < slotCount; i++) {
+        slots[i].readers[0].store(0);
+        slots[i].readers[1].store(0);
+    }
+}
+
+EpochManager::~EpochManager() {
+    for (int i = 0; i < 3; i++) {
+        for (size_t j = 0; j < limbo[i].size(); j++) {
+            limbo[i][j].destroy(limbo[i][j].object);
+        }
+    }
+}
+
+size_t EpochManager::mySlot() {
+    static atomic<size_t> nextSlot(0);
+    thread_local size_t slot = nextSlot.fetch_add(1) % slotCount;
+    return slot;
+}
+
+size_t EpochManager::enter() {
+    size_t slot = mySlot();
+    size_t parity = static_cast<size_t>(epoch.load() & 1);
+    // Operacje seq_cst: rejestracja musi byc widoczna, zanim czytelnik odczyta wskaznik korzenia
+    slots[slot].readers[parity].fetch_add(1);
+    return (slot << 1) | parity;
+}
+
+void EpochManager::exit(size_t token) {
+    slots[token >> 1].readers[token & 1].fetch_sub(1, memory_order_release);
+}
+
+void EpochManager::retire(void* object, void (*destroy)(void*)) {
+    lock_guard<mutex> lock(limboMutex);
+    Retired retired = { object, destroy };
+    limbo[epoch.load() % 3].push_back(retired);
+    if (++retiredSinceAdvance >= advanceThreshold) {
+        tryAdvanceLocked();
+    }
+}
+
+void EpochManager::collect() {
+    lock_guard<mutex> lock(limboMutex);
+    tryAdvanceLocked();
+    // Druga proba pozwala zwolnic takze obiekty z epoki, ktora wlasnie sie skonczyla
+    tryAdvanceLocked();
+}
+
+void EpochManager::tryAdvanceLocked() {
+    retiredSinceAdvance = 0;
+    unsigned long long current = epoch.load();
+    size_t previousParity = static_cast<size_t>((current + 1) & 1); // Parzystosc epoki current - 1
+    for (size_t i = 0; i < slotCount; i++) {
+        if (slots[i].readers[previousParity].load() != 0) {
+            return; // Czytelnik z poprzedniej epoki wciaz dziala - sprobujemy pozniej
+        }
+    }
+
+    epoch.store(current + 1);
+    // Obiekty wycofane w epoce current - 1 nie sa juz widoczne dla zadnego czytelnika
+    vector<Retired>& ready = limbo[(current + 2) % 3];
+    for (size_t j = 0; j < ready.size(); j++) {
+        ready[j].destroy(ready[j].object);
+    }
+    ready.clear();
+}
@@ -0,0 +1,117 @@
+/**
+ * @file EpochManager.h
+ * @brief Definicja klasy EpochManager - odzyskiwania pamieci oparte na epokach (w stylu RCU).
+ * * Czytelnicy rejestruja sie w biezacej epoce na czas jednej operacji, nie blokujac sie
+ * nawzajem ani na pisarzach. Pisarze odkladaja odlaczone obiekty i zwalniaja je dopiero
+ * wtedy, gdy zaden czytelnik nie moze juz ich widziec.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Menedzer epok: rejestracja czytelnikow i odroczone zwalnianie obiektow.
+ * * Czytelnik zwieksza licznik parzystosci biezacej epoki w "swoim" slocie (wybranym na
+ * podstawie identyfikatora watku), wiec rozni czytelnicy rzadko pisza do tej samej linii
+ * pamieci. Epoka moze przejsc z e do e+1 tylko wtedy, gdy zaden czytelnik nie jest
+ * zarejestrowany z parzystoscia e-1. Obiekt wycofany w epoce e jest bezpieczny do
+ * zwolnienia, gdy epoka osiagnie e+2. Ani czytelnicy, ani pisarze nigdy na siebie nie czekaja -
+ * jesli czytelnik dlugo trzyma epoke, wycofane obiekty po prostu czekaja dluzej.
+ */
+class EpochManager {
+private:
+    /// @brief Liczba slotow czytelnikow (watki sa do nich przypisywane modulo).
+    static const size_t slotCount = 64;
+
+    /// @brief Liczniki czytelnikow jednego slotu, wyrownane do linii pamieci podrecznej.
+    struct alignas(64) Slot {
+        atomic<long> readers[2]; ///< Liczba aktywnych czytelnikow dla parzystosci 0 i 1.
+    };
+
+    /// @brief Wycofany obiekt wraz z funkcja, ktora go zwolni.
+    struct Retired {
+        void* object; ///< Wskaznik na obiekt.
+        void (*destroy)(void*); ///< Funkcja zwalniajaca obiekt.
+    };
+
+    Slot slots[slotCount]; ///< Sloty czytelnikow.
+    atomic<unsigned long long> epoch; ///< Biezaca epoka.
+    mutex limboMutex; ///< Chroni listy wycofanych obiektow (uzywany tylko przez pisarzy).
+    vector<Retired> limbo[3]; ///< Obiekty wycofane w epokach e, e-1, e-2 (indeks e % 3).
+    size_t retiredSinceAdvance; ///< Liczba wycofan od ostatniej proby zmiany epoki.
+
+    /**
+     * @brief Zwraca slot przypisany do biezacego watku.
+     * @return Indeks slotu.
+     */
+    static size_t mySlot();
+
+    /**
+     * @brief Probuje przejsc do kolejnej epoki i zwolnic obiekty sprzed dwoch epok.
+     * * Wymaga zalozonego limboMutex.
+     */
+    void tryAdvanceLocked();
+
+public:
+    /// @brief Konstruktor, tworzy menedzera w epoce 0.
+    EpochManager();
+
+    /// @brief Destruktor, zwalnia wszystkie wycofane obiekty (nie moze byc aktywnych czytelnikow).
+    ~EpochManager();
+
+    EpochManager(const EpochManager&) = delete;
+    EpochManager& operator=(const EpochManager&) = delete;
+
+    /**
+     * @brief Rejestruje biezacy watek jako czytelnika.
+     * @return Znacznik, ktory trzeba przekazac do exit().
+     */
+    size_t enter();
+
+    /**
+     * @brief Konczy sekcje czytelnika rozpoczeta przez enter().
+     * @param token Znacznik zwrocony przez enter().
+     */
+    void exit(size_t token);
+
+    /**
+     * @brief Odklada obiekt do zwolnienia, gdy zaden czytelnik nie bedzie go juz widzial.
+     * * Obiekt musi byc juz niedostepny dla nowych czytelnikow.
+     * @param object Wskaznik na obiekt.
+     * @param destroy Funkcja zwalniajaca obiekt.
+     */
+    void retire(void* object, void (*destroy)(void*));
+
+    /**
+     * @brief Probuje zwolnic zalegle obiekty (bez czekania na czytelnikow).
+     */
+    void collect();
+};
+
+/**
+ * @brief Obiekt RAII rejestrujacy czytelnika na czas swojego istnienia.
+ */
+class EpochGuard {
+private:
+    EpochManager& manager; ///< Menedzer, w ktorym zarejestrowano czytelnika.
+    size_t token; ///< Znacznik z EpochManager::enter().
+
+public:
+    /**
+     * @brief Rejestruje czytelnika.
+     * @param manager Menedzer epok.
+     */
+    explicit EpochGuard(EpochManager& manager) : manager(manager), token(manager.enter()) {}
+
+    /// @brief Wyrejestrowuje czytelnika.
+    ~EpochGuard() { manager.exit(token); }
+
+    EpochGuard(const EpochGuard&) = delete;
+    EpochGuard& operator=(const EpochGuard&) = delete;
+};
@@ -0,0 +1,266 @@
+/**
+ * @file ExternalSorter.cpp
+ * @brief Implementacja metod klasy ExternalSorter.
+ */
+
+#include "ExternalSorter.h"
+#include "IntCodec.h"
+#include "TreeSnapshot.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <utility>
+
+using namespace std;
+
+namespace {
+    /// @brief Czyta serie (plik binarny int) buforowanymi blokami.
+    class RunReader {
+    private:
+        ifstream in;
+        vector<int> buffer;
+        size_t length;
+        size_t position;
+
+    public:
+        RunReader(const string& filename, size_t bufferSize)
+            : in(filename, ios::binary), buffer(bufferSize), length(0), position(0) {}
+
+        bool isOpen() const { return in.is_open(); }
+        bool failed() const { return in.bad(); }
+
+        /// @brief Odczytuje kolejna wartosc; false na koncu serii.
+        bool next(int& value) {
+            if (position == length) {
+                in.read(reinterpret_cast<char*>(buffer.data()), static_cast<streamsize>(buffer.size() * sizeof(int)));
+                length = static_cast<size_t>(in.gcount()) / sizeof(int);
+                position = 0;
+                if (length == 0) {
+                    return false;
+                }
+            }
+            value = buffer[position++];
+            return true;
+        }
+    };
+
+    /// @brief Zapisuje wartosci do pliku binarnego buforowanymi blokami.
+    class RunWriter {
+    private:
+        ofstream out;
+        vector<int> buffer;
+
+    public:
+        RunWriter(const string& filename, size_t bufferSize) : out(filename, ios::binary) {
+            buffer.reserve(bufferSize);
+        }
+
+        bool isOpen() const { return out.is_open(); }
+
+        void put(int value) {
+            buffer.push_back(value);
+            if (buffer.size() == buffer.capacity()) {
+                flush();
+            }
+        }
+
+        void flush() {
+            out.write(reinterpret_cast<const char*>(buffer.data()), static_cast<streamsize>(buffer.size() * sizeof(int)));
+            buffer.clear();
+        }
+
+        /// @brief Zapisuje reszte bufora i zamyka plik; false przy bledzie zapisu.
+        bool close() {
+            flush();
+            out.close();
+            return static_cast<bool>(out);
+        }
+    };
+
+    /// @brief Zapisuje cala zawartosc wektora do pliku binarnego.
+    bool writeValues(const string& filename, const vector<int>& values) {
+        ofstream outFile(filename, ios::binary);
+        outFile.write(reinterpret_cast<const char*>(values.data()), static_cast<streamsize>(values.size() * sizeof(int)));
+        outFile.close();
+        return static_cast<bool>(outFile);
+    }
+}
+
+ExternalSorter::ExternalSorter(size_t memoryLimit) : memoryLimit(max(memoryLimit, static_cast<size_t>(minMemoryLimit))) {}
+
+bool ExternalSorter::writeRuns(const string& textFile, const string& sortedFile, vector<string>& runs, unsigned long long& count) {
+    ifstream inFile(textFile, ios::binary);
+    if (!inFile) {
+        cerr << "Blad: Nie mozna otworzyc pliku tekstowego do odczytu: " << textFile << endl;
+        return false;
+    }
+
+    // Blok tekstu daje najwyzej blockSize / 2 + 1 liczb, wiec serie zapisujemy, zanim
+    // kolejny blok moglby przekroczyc zarezerwowany bufor (i limit pamieci)
+    const size_t capacity = (memoryLimit - IntCodec::blockSize) / sizeof(int);
+    const size_t maxPerBlock = IntCodec::blockSize / 2 + 1;
+    vector<int> numbers;
+    numbers.reserve(capacity);
+    vector<char> buffer(IntCodec::blockSize);
+    size_t carry = 0; // Liczba bajtow niedokonczonego tokenu z poprzedniego bloku
+    bool more = true;
+
+    while (more) {
+        inFile.read(buffer.data() + carry, static_cast<streamsize>(buffer.size() - carry));
+        size_t length = carry + static_cast<size_t>(inFile.gcount());
+        size_t complete = length;
+        if (inFile) {
+            // Parsujemy tylko do ostatniego bialego znaku - dalej moze byc przecieta liczba
+            while (complete > 0 && !IntCodec::isSpace(buffer[complete - 1])) {
+                complete--;
+            }
+            if (complete == 0) {
+                // Caly blok to jeden token - na pewno nie jest poprawna liczba
+                complete = length;
+                more = false;
+            }
+        }
+        else {
+            more = false;
+        }
+        if (!IntCodec::parse(buffer.data(), buffer.data() + complete, numbers)) {
+            more = false;
+        }
+        carry = length - complete;
+        memmove(buffer.data(), buffer.data() + complete, carry);
+
+        if (more && numbers.size() + maxPerBlock <= capacity) {
+            continue;
+        }
+
+        sort(numbers.begin(), numbers.end());
+        numbers.erase(unique(numbers.begin(), numbers.end()), numbers.end());
+        if (!more && runs.empty()) {
+            // Wszystko zmiescilo sie w jednej serii - scalanie nie jest potrzebne
+            count = numbers.size();
+            return writeValues(sortedFile, numbers);
+        }
+        string run = sortedFile + ".run" + to_string(temporaryFiles.size());
+        temporaryFiles.push_back(run);
+        runs.push_back(run);
+        if (!writeValues(run, numbers)) {
+            return false;
+        }
+        numbers.clear();
+    }
+    return true;
+}
+
+bool ExternalSorter::merge(const vector<string>& runs, const string& outFile, unsigned long long& count) {
+    // Limit pamieci dzielimy rowno miedzy bufory serii i bufor wyniku
+    const size_t bufferSize = max(memoryLimit / (runs.size() + 1), static_cast<size_t>(minMergeBufferSize)) / sizeof(int);
+    vector<RunReader> readers;
+    readers.reserve(runs.size());
+    for (const string& run : runs) {
+        readers.emplace_back(run, bufferSize);
+        if (!readers.back().isOpen()) {
+            return false;
+        }
+    }
+    RunWriter writer(outFile, bufferSize);
+    if (!writer.isOpen()) {
+        return false;
+    }
+
+    // Kopiec najmniejszych nieodczytanych wartosci serii (wartosc, numer serii)
+    typedef pair<int, size_t> Head;
+    priority_queue<Head, vector<Head>, greater<Head>> heads;
+    for (size_t i = 0; i < readers.size(); i++) {
+        int value;
+        if (readers[i].next(value)) {
+            heads.emplace(value, i);
+        }
+    }
+
+    count = 0;
+    int last = 0;
+    while (!heads.empty()) {
+        Head head = heads.top();
+        heads.pop();
+        // Serie nie maja duplikatow, ale ta sama wartosc moze wystapic w kilku seriach
+        if (count == 0 || head.first != last) {
+            writer.put(head.first);
+            last = head.first;
+            count++;
+        }
+        int value;
+        if (readers[head.second].next(value)) {
+            heads.emplace(value, head.second);
+        }
+    }
+
+    for (const RunReader& reader : readers) {
+        if (reader.failed()) {
+            return false;
+        }
+    }
+    return writer.close();
+}
+
+void ExternalSorter::removeTemporaryFiles() {
+    for (const string& file : temporaryFiles) {
+        error_code error;
+        filesystem::remove(file, error);
+    }
+    temporaryFiles.clear();
+}
+
+bool ExternalSorter::sortText(const string& textFile, const string& sortedFile, unsigned long long& count) {
+    count = 0;
+    vector<string> runs;
+    bool ok = writeRuns(textFile, sortedFile, runs, count);
+
+    // Przy zbyt wielu seriach scalamy je grupami, az zmieszcza sie w jednym scalaniu
+    const size_t fanIn = memoryLimit / minMergeBufferSize - 1;
+    while (ok && runs.size() > fanIn) {
+        vector<string> merged;
+        for (size_t first = 0; ok && first < runs.size(); first += fanIn) {
+            vector<string> group(runs.begin() + first, runs.begin() + min(first + fanIn, runs.size()));
+            string run = sortedFile + ".run" + to_string(temporaryFiles.size());
+            temporaryFiles.push_back(run);
+            merged.push_back(run);
+            unsigned long long groupCount = 0;
+            ok = merge(group, run, groupCount);
+            for (const string& file : group) {
+                error_code error;
+                filesystem::remove(file, error); // Zwalniamy miejsce na dysku od razu
+            }
+        }
+        runs.swap(merged);
+    }
+    if (ok && !runs.empty()) {
+        ok = merge(runs, sortedFile, count);
+    }
+
+    removeTemporaryFiles();
+    if (!ok) {
+        cerr << "Blad: Sortowanie zewnetrzne nie powiodlo sie (plik: " << textFile << ")" << endl;
+    }
+    return ok;
+}
+
+bool ExternalSorter::buildSnapshot(const string& textFile, const string& snapshotFile) {
+    const string sortedFile = snapshotFile + ".sorted";
+    unsigned long long count = 0;
+    bool ok = sortText(textFile, sortedFile, count);
+    if (ok) {
+        ifstream sorted(sortedFile, ios::binary);
+        ok = sorted && TreeSnapshot::writeSorted(snapshotFile, sorted, count);
+        if (!ok) {
+            cerr << "Blad: Nie mozna zapisac migawki: " << snapshotFile << endl;
+        }
+    }
+
+    error_code error;
+    filesystem::remove(sortedFile, error);
+    return ok;
+}
@@ -0,0 +1,95 @@
+/**
+ * @file ExternalSorter.h
+ * @brief Definicja klasy ExternalSorter - budowy migawki drzewa z pliku wiekszego niz pamiec RAM.
+ * * FileHandler::loadFromText tworzy wezel (kilkadziesiat bajtow) dla kazdej liczby, wiec
+ * plik z miliardami liczb nie zmiesci sie w pamieci jako drzewo. ExternalSorter sortuje
+ * liczby zewnetrznie (posortowane serie na dysku, potem scalanie) i zapisuje wynik od razu
+ * jako migawke TreeSnapshot, ktora mozna przeszukiwac bez budowania drzewa wskaznikowego.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Sortowanie zewnetrzne liczb z pliku tekstowego w ograniczonej pamieci.
+ * * Przebieg:
+ *   1. plik tekstowy jest czytany blokami; liczby trafiaja do bufora serii, ktory po
+ *      zapelnieniu jest sortowany, oczyszczany z duplikatow i zapisywany jako seria
+ *      (plik binarny int w natywnej kolejnosci bajtow),
+ *   2. serie sa scalane kopcem po co najwyzej tyle naraz, ile buforow odczytu miesci
+ *      sie w limicie pamieci (przy wiekszej liczbie serii scalanie jest wieloprzebiegowe),
+ *   3. wynik (rosnaco, bez duplikatow - tak jak w BST) jest zapisywany przez
+ *      TreeSnapshot::writeSorted.
+ * Pliki tymczasowe powstaja obok pliku wynikowego (nazwa posortowanego pliku + ".runN",
+ * a w buildSnapshot posortowany plik to nazwa migawki + ".sorted") i sa usuwane po
+ * zakonczeniu, rowniez po bledzie. Liczby sa czytane jak w loadFromText:
+ * do konca pliku albo do pierwszego nieprawidlowego tokenu.
+ */
+class ExternalSorter {
+private:
+    size_t memoryLimit; ///< Limit pamieci na bufory sortowania i scalania w bajtach.
+    vector<string> temporaryFiles; ///< Utworzone pliki tymczasowe (do usuniecia w removeTemporaryFiles).
+
+    /// @brief Najmniejszy bufor odczytu jednej serii przy scalaniu (w bajtach).
+    static const size_t minMergeBufferSize = 1 << 16;
+
+    /**
+     * @brief Dzieli plik tekstowy na posortowane serie bez duplikatow.
+     * * Jesli wszystkie liczby zmieszcza sie w jednej serii, trafiaja od razu do sortedFile.
+     * @param textFile Plik z liczbami.
+     * @param sortedFile Plik wynikowy sortowania (uzywany, gdy powstaje tylko jedna seria).
+     * @param runs Nazwy plikow serii (pusty wektor, jesli wynik jest juz w sortedFile).
+     * @param count Liczba wartosci w sortedFile (gdy runs jest pusty).
+     * @return true jesli sie powiodlo.
+     */
+    bool writeRuns(const string& textFile, const string& sortedFile, vector<string>& runs, unsigned long long& count);
+
+    /**
+     * @brief Scala serie w jeden plik, usuwajac duplikaty miedzy seriami.
+     * @param runs Nazwy plikow serii.
+     * @param outFile Plik wynikowy.
+     * @param count Liczba wartosci zapisanych do outFile.
+     * @return true jesli sie powiodlo.
+     */
+    bool merge(const vector<string>& runs, const string& outFile, unsigned long long& count);
+
+    /// @brief Usuwa wszystkie utworzone pliki tymczasowe.
+    void removeTemporaryFiles();
+
+public:
+    /// @brief Domyslny limit pamieci (64 MiB).
+    static const size_t defaultMemoryLimit = 64 << 20;
+
+    /// @brief Najmniejszy akceptowany limit pamieci (mniejsze wartosci sa zwiekszane do niego).
+    static const size_t minMemoryLimit = 4 << 20;
+
+    /**
+     * @brief Konstruktor.
+     * @param memoryLimit Limit pamieci na bufory w bajtach (wielkosc serii i buforow scalania).
+     */
+    explicit ExternalSorter(size_t memoryLimit = defaultMemoryLimit);
+
+    /**
+     * @brief Sortuje liczby z pliku tekstowego do pliku binarnego.
+     * @param textFile Plik z liczbami oddzielonymi bialymi znakami.
+     * @param sortedFile Plik wynikowy: wartosci int (natywna kolejnosc bajtow) rosnaco, bez duplikatow.
+     * @param count Liczba zapisanych wartosci.
+     * @return true jesli sie powiodlo.
+     */
+    bool sortText(const string& textFile, const string& sortedFile, unsigned long long& count);
+
+    /**
+     * @brief Buduje migawke TreeSnapshot z pliku tekstowego w ograniczonej pamieci.
+     * * Wynik jest taki sam, jak zapis migawki drzewa wczytanego z tego pliku przez
+     * FileHandler::loadFromText, a migawke otwiera sie zwyklym TreeSnapshot::open.
+     * @param textFile Plik z liczbami oddzielonymi bialymi znakami.
+     * @param snapshotFile Plik wynikowy migawki.
+     * @return true jesli sie powiodlo.
+     */
+    bool buildSnapshot(const string& textFile, const string& snapshotFile);
+};
@@ -0,0 +1,168 @@
+/**
+ * @file EytzingerLayout.cpp
+ * @brief Implementacja metod klasy EytzingerLayout.
+ */
+
+#include "EytzingerLayout.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#include <xmmintrin.h>
+#endif
+
+using namespace std;
+
+namespace {
+    /// @brief Podpowiada procesorowi, ze wskazana pamiec bedzie wkrotce czytana.
+    inline void prefetch(const int* address) {
+#ifdef _MSC_VER
+        _mm_prefetch(reinterpret_cast<const char*>(address), _MM_HINT_T0);
+#else
+        __builtin_prefetch(address);
+#endif
+    }
+
+    /// @brief Zwraca liczbe jedynek na najmlodszych bitach liczby.
+    inline unsigned trailingOnes(size_t value) {
+        size_t inverted = ~value; // Nigdy zero - indeksy nie zajmuja wszystkich bitow
+#if defined(_MSC_VER) && defined(_WIN64)
+        unsigned long index;
+        _BitScanForward64(&index, inverted);
+        return index;
+#elif defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, inverted);
+        return index;
+#else
+        return static_cast<unsigned>(__builtin_ctzll(inverted));
+#endif
+    }
+
+    /// @brief Liczba zapytan przetwarzanych rownolegle w jednej grupie.
+    const size_t batchLanes = 16;
+
+    /// @brief Zwraca liczbe poziomow drzewa Eytzingera o count wezlach.
+    inline unsigned levelCount(size_t count) {
+        unsigned levels = 0;
+        while (count > 0) {
+            levels++;
+            count >>= 1;
+        }
+        return levels;
+    }
+
+    /**
+     * @brief Schodzi po drzewie z grupa lanes zapytan naraz.
+     * * Pierwsze levels-1 poziomow istnieje dla kazdej sciezki, wiec petla nie potrzebuje
+     * warunkow; tylko ostatni, niepelny poziom jest sprawdzany osobno dla kazdego zapytania.
+     */
+    inline void descendGroup(const int* keys, size_t count, unsigned levels,
+        const int* queries, size_t lanes, size_t* k) {
+        for (size_t lane = 0; lane < lanes; lane++) {
+            k[lane] = 1;
+        }
+        for (unsigned level = 1; level < levels; level++) {
+            for (size_t lane = 0; lane < lanes; lane++) {
+                k[lane] = 2 * k[lane] + (keys[k[lane]] < queries[lane]);
+                prefetch(keys + 16 * k[lane]);
+            }
+        }
+        for (size_t lane = 0; lane < lanes; lane++) {
+            if (k[lane] <= count) {
+                k[lane] = 2 * k[lane] + (keys[k[lane]] < queries[lane]);
+            }
+        }
+    }
+
+    /**
+     * @brief Wyznacza indeksy lower bound (0 = brak) dla jednej grupy co najwyzej batchLanes zapytan.
+     */
+    inline void descendBatch(const int* keys, size_t count, const int* queries, size_t lanes, size_t* k) {
+        if (count == 0) {
+            for (size_t lane = 0; lane < lanes; lane++) {
+                k[lane] = 0;
+            }
+            return;
+        }
+
+        const unsigned levels = levelCount(count);
+        descendGroup(keys, count, levels, queries, lanes, k);
+        // Cofamy sie o wszystkie kroki w prawo i jeden w lewo, jak w lowerBound
+        for (size_t lane = 0; lane < lanes; lane++) {
+            k[lane] >>= trailingOnes(k[lane]) + 1;
+        }
+    }
+}
+
+void EytzingerLayout::build(const vector<int>& sorted, int* out) {
+    // Przechodzimy niejawne drzewo w kolejnosci Inorder i przypisujemy kolejne wartosci
+    size_t count = sorted.size();
+    size_t next = 0;
+    size_t k = 1;
+    vector<size_t> stack; // Glebokosc O(log n)
+    while (k <= count || !stack.empty()) {
+        while (k <= count) {
+            stack.push_back(k);
+            k = 2 * k;
+        }
+        k = stack.back();
+        stack.pop_back();
+        out[k] = sorted[next++];
+        k = 2 * k + 1;
+    }
+}
+
+size_t EytzingerLayout::lowerBound(const int* keys, size_t count, int data) {
+    size_t k = 1;
+    while (k <= count) {
+        // 16 wartosci int to jedna linia 64 B: wnuki wnukow wezla k zaczynaja sie pod 16k
+        prefetch(keys + 16 * k);
+        k = 2 * k + (keys[k] < data);
+    }
+    // Cofamy sie o wszystkie kroki w prawo i jeden w lewo - to ostatni wezel >= data
+    return k >> (trailingOnes(k) + 1);
+}
+
+void EytzingerLayout::lowerBoundBatch(const int* keys, size_t count, const int* queries,
+    size_t queryCount, int* values, bool* found) {
+    size_t indexes[batchLanes];
+    for (size_t first = 0; first < queryCount; first += batchLanes) {
+        size_t lanes = (queryCount - first < batchLanes) ? queryCount - first : batchLanes;
+        descendBatch(keys, count, queries + first, lanes, indexes);
+        for (size_t lane = 0; lane < lanes; lane++) {
+            found[first + lane] = indexes[lane] != 0;
+            values[first + lane] = (indexes[lane] != 0) ? keys[indexes[lane]] : 0;
+        }
+    }
+}
+
+void EytzingerLayout::containsBatch(const int* keys, size_t count, const int* queries,
+    size_t queryCount, bool* found) {
+    size_t indexes[batchLanes];
+    for (size_t first = 0; first < queryCount; first += batchLanes) {
+        size_t lanes = (queryCount - first < batchLanes) ? queryCount - first : batchLanes;
+        descendBatch(keys, count, queries + first, lanes, indexes);
+        for (size_t lane = 0; lane < lanes; lane++) {
+            found[first + lane] = indexes[lane] != 0 && keys[indexes[lane]] == queries[first + lane];
+        }
+    }
+}
+
+bool EytzingerLayout::contains(const int* keys, size_t count, int data) {
+    size_t k = lowerBound(keys, count, data);
+    return k != 0 && keys[k] == data;
+}
+
+vector<int> EytzingerLayout::findPath(const int* keys, size_t count, int data) {
+    vector<int> path;
+    size_t k = 1;
+    while (k <= count) {
+        path.push_back(keys[k]);
+        if (keys[k] == data) {
+            return path;
+        }
+        k = 2 * k + (keys[k] < data ? 1 : 0);
+    }
+    path.clear();
+    return path;
+}
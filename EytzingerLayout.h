@@ -0,0 +1,83 @@
+/**
+ * @file EytzingerLayout.h
+ * @brief Definicja klasy EytzingerLayout - operacji na drzewie zapisanym w tablicy (uklad Eytzingera).
+ * * W ukladzie Eytzingera korzen lezy pod indeksem 1, a dzieci wezla k pod indeksami
+ * 2k i 2k+1 (jak w kopcu binarnym). Drzewo nie potrzebuje wskaznikow, wiec moze
+ * byc zapisane w pliku i przeszukiwane bezposrednio w pamieci (np. po mmap).
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Zestaw statycznych metod budujacych i przeszukujacych tablice w ukladzie Eytzingera.
+ * * Tablica ma count + 1 elementow; element o indeksie 0 jest nieuzywany (wypelnienie),
+ * dzieki czemu arytmetyka indeksow jest najprostsza.
+ */
+class EytzingerLayout {
+public:
+    /**
+     * @brief Uklada posortowane wartosci w kolejnosci Eytzingera.
+     * @param sorted Wartosci posortowane rosnaco, bez duplikatow.
+     * @param out Tablica wyjsciowa o rozmiarze co najmniej sorted.size() + 1.
+     */
+    static void build(const vector<int>& sorted, int* out);
+
+    /**
+     * @brief Znajduje pozycje najmniejszej wartosci >= data (lower bound).
+     * * Przeszukiwanie jest bezskokowe (bez nieprzewidywalnych rozgalezien) i pobiera
+     * z wyprzedzeniem linie pamieci z wezlami lezacymi 4 poziomy nizej.
+     * @param keys Tablica w ukladzie Eytzingera (z elementem 0 jako wypelnieniem).
+     * @param count Liczba wartosci (bez wypelnienia).
+     * @param data Szukana wartosc.
+     * @return Indeks w tablicy lub 0, jesli wszystkie wartosci sa mniejsze od data.
+     */
+    static size_t lowerBound(const int* keys, size_t count, int data);
+
+    /**
+     * @brief Wyznacza lower bound (najmniejsza wartosc >= zapytanie) dla wielu zapytan naraz.
+     * * Zapytania sa przetwarzane grupami po 16, ktore schodza po drzewie rownolegle (poziom
+     * po poziomie), wiec opoznienia odczytow z pamieci sie nakladaju. Metoda nie alokuje pamieci.
+     * @param keys Tablica w ukladzie Eytzingera.
+     * @param count Liczba wartosci.
+     * @param queries Szukane wartosci.
+     * @param queryCount Liczba zapytan.
+     * @param values Wyniki: znaleziona wartosc (0, gdy found[i] == false).
+     * @param found Wyniki: czy istnieje wartosc >= queries[i].
+     */
+    static void lowerBoundBatch(const int* keys, size_t count, const int* queries, size_t queryCount,
+        int* values, bool* found);
+
+    /**
+     * @brief Sprawdza przynaleznosc wielu wartosci naraz (jak lowerBoundBatch, bez alokacji).
+     * @param keys Tablica w ukladzie Eytzingera.
+     * @param count Liczba wartosci.
+     * @param queries Szukane wartosci.
+     * @param queryCount Liczba zapytan.
+     * @param found Wyniki: czy queries[i] wystepuje w tablicy.
+     */
+    static void containsBatch(const int* keys, size_t count, const int* queries, size_t queryCount,
+        bool* found);
+
+    /**
+     * @brief Sprawdza, czy wartosc wystepuje w tablicy.
+     * @param keys Tablica w ukladzie Eytzingera (z elementem 0 jako wypelnieniem).
+     * @param count Liczba wartosci (bez wypelnienia).
+     * @param data Szukana wartosc.
+     * @return true jesli wartosc zostala znaleziona.
+     */
+    static bool contains(const int* keys, size_t count, int data);
+
+    /**
+     * @brief Wyszukuje sciezke od korzenia do wartosci (w niejawnym drzewie tablicy).
+     * @param keys Tablica w ukladzie Eytzingera.
+     * @param count Liczba wartosci.
+     * @param data Szukana wartosc.
+     * @return Wartosci wezlow na sciezce; pusty wektor, jesli wartosci nie znaleziono.
+     */
+    static vector<int> findPath(const int* keys, size_t count, int data);
+};
@@ -1,57 +1,231 @@
 /**
  * @file FileHandler.h
- * @brief Definicja klasy FileHandler.
+ * @brief Definicja szablonu BasicFileHandler i typu FileHandler dla drzewa BST (klucze int).
  * * Klasa ta odpowiada za operacje wejscia/wyjscia na plikach (tekstowych i binarnych)
- * w celu zapisywania i odczytywania struktury drzewa BST.
+ * w celu zapisywania i odczytywania struktury drzewa BST. Implementacja znajduje sie
+ * w FileHandler.tpp.
  */
 
 #pragma once
 
+#include <future>
 #include <string>
+#include <vector>
 #include "BST.h" // Potrzebujemy pelnej definicji BST
+#include "ConcurrentBST.h"
+#include "PersistentBST.h"
 
 using namespace std;
 
  /**
-  * @brief Klasa obslugujaca operacje plikowe dla drzewa BST.
+  * @brief Klasa obslugujaca operacje plikowe dla drzewa BasicBST o tych samych parametrach.
   * * Umozliwia zapisywanie stanu drzewa do plikow tekstowych i binarnych
   * oraz odczytywanie danych (zastepujac lub dodajac do) drzewa.
   * Jest zaprzyjazniona z klasa BST, aby miec dostep do jej prywatnych metod.
+  * Sposob zapisu kluczy wybiera w czasie kompilacji KeyCodec, a wartosci (tryb slownika) - ValueCodec.
   */
-class FileHandler {
+template <typename Key = int, typename Compare = less<Key>, typename Allocator = allocator<Key>, typename Value = NoValue>
+class BasicFileHandler {
+private:
+    /// @brief Typ obslugiwanego drzewa.
+    typedef BasicBST<Key, Compare, Allocator, Value> Tree;
+
+    /// @brief Kodek kluczy (ten sam, ktorego uzywa drzewo).
+    typedef KeyCodec<Key, Compare> Codec;
+
+    // Format binarny v2:
+    //   bajty 0-3  magic "BSTB"
+    //   bajt  4    wersja formatu (2)
+    //   bajt  5    kolejnosc bajtow pol naglowka (1 = little-endian)
+    //   bajt  6    rozmiar klucza w bajtach (0 = int, jak w plikach sprzed szablonow)
+    //   bajt  7    kodowanie kluczy (0 = roznice jako varint, 1 = surowe bajty);
+    //              najwyzszy bit oznacza plik slownika (z sekcja wartosci)
+    //   bajty 8-15 liczba elementow (uint64, little-endian)
+    //   dalej      klucze rosnaco (patrz KeyCodec), a w slowniku po nich wartosci (patrz ValueCodec)
+    static const char binaryMagic[4];
+    static const char binaryVersion = 2;
+    static const char littleEndianMarker = 1;
+    static const size_t binaryHeaderSize = 16;
+    static const unsigned char mapFlag = 0x80;
+
+    /// @brief Zwraca bajt kodowania z naglowka (kodowanie kluczy i znacznik slownika).
+    static unsigned char binaryEncoding() {
+        return Codec::binaryEncoding | (Tree::HasValue::value ? mapFlag : 0);
+    }
+
+    /**
+     * @brief Zapisuje naglowek pliku binarnego v2.
+     * @param outFile Strumien wyjsciowy pliku binarnego.
+     * @param count Liczba elementow.
+     */
+    static void writeHeader(ofstream& outFile, unsigned long long count);
+
+    /**
+     * @brief Odczytuje naglowek pliku binarnego v2 i pobiera z niego liczbe elementow.
+     * * Przy bledzie wypisuje komunikat na cerr. Plik bez naglowka v2 (stary format) jest
+     * bledem, chyba ze allowLegacy - wtedy legacy = true, a strumien wraca na poczatek pliku.
+     * @param inFile Strumien pliku binarnego ustawiony na poczatku pliku.
+     * @param filename Nazwa pliku (do komunikatow bledow).
+     * @param allowLegacy Czy akceptowac plik w starym formacie.
+     * @param legacy Czy plik jest w starym formacie (count nie jest wtedy ustawiany).
+     * @param count Liczba elementow zapisana w naglowku.
+     * @return true jesli naglowek pasuje do tego typu drzewa (lub plik jest w akceptowanym starym formacie).
+     */
+    static bool readHeader(ifstream& inFile, const string& filename, bool allowLegacy, bool& legacy, unsigned long long& count);
+
+    /**
+     * @brief Zapisuje plik binarny z kopii zawartosci drzewa (uzywane przez saveToBinaryAsync).
+     * @param filename Nazwa binarnego pliku wyjsciowego.
+     * @param keys Klucze rosnaco.
+     * @param values Wartosci kolejnych kluczy (pusty wektor, jesli drzewo nie ma wartosci).
+     * @return true jesli zapis sie powiodl.
+     */
+    bool writeBinary(const string& filename, const vector<Key>& keys, const vector<Value>& values);
+
+    /// @brief Histogramy czasow operacji (puste, jesli BST_STATS nie jest wlaczone).
+    FileCounters<statsEnabled> counters;
+
 public:
     /**
      * @brief Zapisuje drzewo do pliku tekstowego (w kolejnosci Inorder).
+     * * W trybie slownika kazda linia zawiera klucz i wartosc oddzielone spacja.
      * @param tree Referencja do obiektu drzewa BST, ktore ma byc zapisane.
      * @param filename Nazwa pliku wyjsciowego.
      * @return true jesli zapis sie powiodl, false w przeciwnym razie.
      */
-    bool saveToText(BST& tree, const string& filename);
+    bool saveToText(Tree& tree, const string& filename);
 
     /**
-     * @brief Zapisuje (serializuje) cala strukture drzewa do pliku binarnego.
+     * @brief Zapisuje (serializuje) zawartosc drzewa do pliku binarnego.
+     * * Plik zaczyna sie 16-bajtowym naglowkiem (magic "BSTB", wersja, kolejnosc bajtow,
+     * typ klucza, liczba elementow), po ktorym nastepuja posortowane wartosci - dla int
+     * zakodowane roznicowo jako varinty.
      * @param tree Referencja do obiektu drzewa BST.
      * @param filename Nazwa binarnego pliku wyjsciowego.
      * @return true jesli zapis sie powiodl, false w przeciwnym razie.
      */
-    bool saveToBinary(BST& tree, const string& filename);
+    bool saveToBinary(Tree& tree, const string& filename);
+
+    /**
+     * @brief Zapisuje drzewo do pliku binarnego w tle (ten sam format co saveToBinary).
+     * * BasicBST nie ma wersji kopiowanych przy zapisie, wiec na watku wywolujacym powstaje
+     * plaska kopia kluczy (i wartosci) - stan drzewa z chwili wywolania; kosztuje to tyle, co
+     * przejscie drzewa. Kodowanie i zapis pliku duzymi blokami odbywaja sie na osobnym watku,
+     * wiec po powrocie z metody drzewo mozna od razu dalej zmieniac i przeszukiwac.
+     * @note Obiekt BasicFileHandler musi istniec do zakonczenia zapisu. Destruktor zwroconego
+     * future czeka na koniec zapisu, wiec nalezy go zachowac, a nie od razu porzucic.
+     * @param tree Referencja do obiektu drzewa BST.
+     * @param filename Nazwa binarnego pliku wyjsciowego.
+     * @return future z wynikiem zapisu (true jesli sie powiodl).
+     */
+    future<bool> saveToBinaryAsync(const Tree& tree, const string& filename);
+
+    /**
+     * @brief Zapisuje drzewo ConcurrentBST do pliku binarnego w tle, bez zadnej kopii na watku wywolujacym.
+     * * Metoda czeka tylko, az watek w tle ustali (przypnie epoka) aktualna wersje drzewa - zapisany
+     * zostanie stan z chwili wywolania. Wezly tej wersji sa niezmienne, wiec insert, remove
+     * i wyszukiwania dzialaja w trakcie zapisu bez przerw. Plik ma ten sam format co saveToBinary i wczytuje sie przez loadFromBinary.
+     * Dostepne tylko dla FileHandler (klucze int, bez wartosci).
+     * @note Drzewo i obiekt BasicFileHandler musza istniec do zakonczenia zapisu.
+     * @param tree Referencja do drzewa ConcurrentBST.
+     * @param filename Nazwa binarnego pliku wyjsciowego.
+     * @return future z wynikiem zapisu (true jesli sie powiodl).
+     */
+    future<bool> saveToBinaryAsync(const ConcurrentBST& tree, const string& filename);
 
     /**
-     * @brief Wczytuje (deserializuje) cala strukture drzewa z pliku binarnego.
+     * @brief Zapisuje dowolna wersje drzewa PersistentBST do pliku tekstowego (rosnaco).
+     * * Dostepne tylko dla FileHandler (klucze int, bez wartosci).
+     * @param tree Wersja drzewa.
+     * @param filename Nazwa pliku wyjsciowego.
+     * @return true jesli zapis sie powiodl, false w przeciwnym razie.
+     */
+    bool saveToText(const PersistentBST& tree, const string& filename);
+
+    /**
+     * @brief Zapisuje dowolna wersje drzewa PersistentBST do pliku binarnego.
+     * * Plik ma ten sam format co saveToBinary, wiec mozna go wczytac zarowno do BST,
+     * jak i do PersistentBST. Dostepne tylko dla FileHandler (klucze int, bez wartosci).
+     * @param tree Wersja drzewa.
+     * @param filename Nazwa binarnego pliku wyjsciowego.
+     * @return true jesli zapis sie powiodl, false w przeciwnym razie.
+     */
+    bool saveToBinary(const PersistentBST& tree, const string& filename);
+
+    /**
+     * @brief Zapisuje wersje drzewa PersistentBST do pliku binarnego w tle.
+     * * Wersja jest niezmienna, wiec wystarcza jej migawka w O(1) - metoda wraca od razu,
+     * a nowe wersje mozna tworzyc w trakcie zapisu. Dostepne tylko dla FileHandler.
+     * @note Obiekt BasicFileHandler musi istniec do zakonczenia zapisu.
+     * @param tree Wersja drzewa.
+     * @param filename Nazwa binarnego pliku wyjsciowego.
+     * @return future z wynikiem zapisu (true jesli sie powiodl).
+     */
+    future<bool> saveToBinaryAsync(const PersistentBST& tree, const string& filename);
+
+    /**
+     * @brief Wczytuje wersje drzewa PersistentBST z pliku binarnego v2 (idealnie zrownowazona).
+     * * Pliki w starym formacie (bez naglowka) nie sa obslugiwane. Dostepne tylko dla FileHandler.
+     * @param tree Wersja, ktora zostanie zastapiona wczytanym drzewem (inne wersje sie nie zmieniaja).
+     * @param filename Nazwa binarnego pliku wejsciowego.
+     * @return true jesli odczyt sie powiodl, false w przeciwnym razie.
+     */
+    bool loadFromBinary(PersistentBST& tree, const string& filename);
+
+    /**
+     * @brief Wczytuje (deserializuje) drzewo z pliku binarnego.
+     * * Pliki w formacie v2 sa odtwarzane jako idealnie zrownowazone drzewo; pliki w starym
+     * formacie (bez naglowka) sa odczytywane z zachowaniem zapisanej struktury. Plik zapisany
+     * dla innego typu klucza (albo slownik zamiast zbioru kluczy i odwrotnie) jest odrzucany.
      * @warning Ta operacja usuwa (czysci) istniejace drzewo przed wczytaniem.
      * @param tree Referencja do obiektu drzewa BST, ktore ma byc zastapione.
      * @param filename Nazwa binarnego pliku wejsciowego.
+     * @param threads Liczba watkow budujacych drzewo z pliku v2; 0 oznacza liczbe rdzeni.
      * @return true jesli odczyt sie powiodl, false w przeciwnym razie.
      */
-    bool loadFromBinary(BST& tree, const string& filename);
+    bool loadFromBinary(Tree& tree, const string& filename, unsigned threads = 1);
 
     /**
      * @brief Wczytuje liczby z pliku tekstowego i dodaje je do drzewa.
+     * * W trybie slownika plik zawiera pary "klucz wartosc"; klucze juz obecne w drzewie
+     * zachowuja swoje wartosci.
      * @note Ta operacja dodaje elementy do istniejacego drzewa (nie czysci go).
+     * Drzewo jest przebudowywane naraz (BST::bulkLoad) jako idealnie zrownowazone.
+     * Przy threads > 1 plik jest wczytywany w calosci do pamieci, dzielony na fragmenty
+     * parsowane rownolegle, a sortowanie i budowa drzewa rowniez odbywaja sie na wielu watkach.
+     * Plik bez mozliwosci przewijania (np. potok) jest czytany sekwencyjnie.
      * @param tree Referencja do obiektu drzewa BST.
      * @param filename Nazwa pliku tekstowego z danymi (liczby oddzielone bialymi znakami).
+     * @param threads Liczba watkow; 0 oznacza liczbe rdzeni procesora.
      * @return true jesli odczyt sie powiodl, false w przeciwnym razie.
      */
-    bool loadFromText(BST& tree, const string& filename);
+    bool loadFromText(Tree& tree, const string& filename, unsigned threads = 1);
+
+    /**
+     * @brief Zapisuje migawke drzewa, ktora mozna przeszukiwac w miejscu po zmapowaniu (TreeSnapshot).
+     * * Dostepne tylko dla kluczy int.
+     * @param tree Referencja do obiektu drzewa BST.
+     * @param filename Nazwa pliku migawki.
+     * @return true jesli zapis sie powiodl, false w przeciwnym razie.
+     */
+    bool saveSnapshot(Tree& tree, const string& filename);
+
+    /**
+     * @brief Zwraca migawke histogramow czasow zapisu i odczytu (patrz Stats.h).
+     * * Czasy sa mierzone tylko przy BST_STATS=1; inaczej histogramy sa puste.
+     * @return Aktualne statystyki.
+     */
+    FileStats getStats() const;
+
+    /// @brief Zeruje histogramy czasow.
+    void resetStats();
 };
+
+#include "FileHandler.tpp"
+
+/// @brief Obsluga plikow dla drzewa BST (klucze int).
+typedef BasicFileHandler<> FileHandler;
+
+// Wersja dla int jest instancjonowana raz, w FileHandler.cpp
+extern template class BasicFileHandler<>;
 //test
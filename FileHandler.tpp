@@ -0,0 +1,403 @@
+/**
+ * @file FileHandler.tpp
+ * @brief Implementacja metod szablonu BasicFileHandler (dolaczana na koncu FileHandler.h).
+ */
+
+#pragma once
+
+#include "IntCodec.h"
+#include "ParallelTasks.h"
+#include "TreeSnapshot.h"
+#include <fstream>
+#include <iostream>
+#include <cstring> // Do memcpy, memcmp
+#include <vector>
+#include <utility> // Do move
+#include <algorithm> // Do min, max
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+const char BasicFileHandler<Key, Compare, Allocator, Value>::binaryMagic[4] = { 'B', 'S', 'T', 'B' };
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+bool BasicFileHandler<Key, Compare, Allocator, Value>::saveToText(Tree& tree, const string& filename) {
+    ScopedTimer<statsEnabled> timer(counters.textSave);
+    ofstream outFile(filename);
+    if (!outFile) {
+        cerr << "Blad: Nie mozna otworzyc pliku do zapisu: " << filename << endl;
+        return false;
+    }
+    // Wywolujemy prywatna metode pomocnicza z klasy BST
+    tree.saveToText(tree.root, outFile);
+    outFile.close();
+    return true;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+void BasicFileHandler<Key, Compare, Allocator, Value>::writeHeader(ofstream& outFile, unsigned long long count) {
+    // Naglowek: magic, wersja, kolejnosc bajtow, zarezerwowane, liczba elementow
+    char header[binaryHeaderSize] = {};
+    memcpy(header, binaryMagic, sizeof(binaryMagic));
+    header[4] = binaryVersion;
+    header[5] = littleEndianMarker;
+    header[6] = static_cast<char>(Codec::binaryKeySize);
+    header[7] = static_cast<char>(binaryEncoding());
+    for (int i = 0; i < 8; i++) {
+        header[8 + i] = static_cast<char>((count >> (8 * i)) & 0xFF);
+    }
+    outFile.write(header, binaryHeaderSize);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+bool BasicFileHandler<Key, Compare, Allocator, Value>::saveToBinary(Tree& tree, const string& filename) {
+    ScopedTimer<statsEnabled> timer(counters.binarySave);
+    ofstream outFile(filename, ios::binary);
+    if (!outFile) {
+        cerr << "Blad: Nie mozna otworzyc pliku binarnego do zapisu: " << filename << endl;
+        return false;
+    }
+
+    writeHeader(outFile, tree.getSize());
+
+    // Wywolujemy prywatna metode pomocnicza z klasy BST
+    tree.serialize(tree.root, outFile);
+    outFile.close();
+    return static_cast<bool>(outFile);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+bool BasicFileHandler<Key, Compare, Allocator, Value>::writeBinary(const string& filename, const vector<Key>& keys, const vector<Value>& values) {
+    ScopedTimer<statsEnabled> timer(counters.binarySave);
+    ofstream outFile(filename, ios::binary);
+    if (!outFile) {
+        cerr << "Blad: Nie mozna otworzyc pliku binarnego do zapisu: " << filename << endl;
+        return false;
+    }
+    writeHeader(outFile, keys.size());
+
+    typename Codec::BinaryWriter writer(outFile);
+    for (size_t i = 0; i < keys.size(); i++) {
+        writer.put(keys[i]);
+    }
+    writer.flush();
+    for (size_t i = 0; i < values.size(); i++) {
+        ValueCodec<Value>::writeBinary(outFile, values[i]);
+    }
+    outFile.close();
+    if (!outFile) {
+        cerr << "Blad: Nie udalo sie zapisac pliku binarnego: " << filename << endl;
+        return false;
+    }
+    return true;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+future<bool> BasicFileHandler<Key, Compare, Allocator, Value>::saveToBinaryAsync(const Tree& tree, const string& filename) {
+    static_assert(is_copy_constructible<Value>::value, "Zapis w tle kopiuje wartosci - typ wartosci musi byc kopiowalny");
+
+    // Spojny stan z chwili wywolania: plaska kopia, bez kodowania i bez operacji na pliku
+    vector<Key> keys;
+    vector<Value> values;
+    keys.reserve(tree.getSize());
+    if (Tree::HasValue::value) {
+        values.reserve(tree.getSize());
+    }
+    // Wywolujemy prywatna metode pomocnicza z klasy BST
+    tree.copyEntries(keys, values);
+
+    return async(launch::async, [this, filename](vector<Key> keys, vector<Value> values) {
+        return writeBinary(filename, keys, values);
+    }, move(keys), move(values));
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+future<bool> BasicFileHandler<Key, Compare, Allocator, Value>::saveToBinaryAsync(const ConcurrentBST& tree, const string& filename) {
+    static_assert(is_same<Key, int>::value && is_same<Compare, less<int>>::value && !Tree::HasValue::value,
+        "ConcurrentBST przechowuje tylko klucze int bez wartosci");
+
+    promise<void> started;
+    future<void> pinned = started.get_future();
+    future<bool> result = async(launch::async, [this, &tree, filename, started = move(started)]() mutable {
+        ScopedTimer<statsEnabled> timer(counters.binarySave);
+        ofstream outFile(filename, ios::binary);
+        if (!outFile) {
+            started.set_value();
+            cerr << "Blad: Nie mozna otworzyc pliku binarnego do zapisu: " << filename << endl;
+            return false;
+        }
+
+        // Liczbe elementow zapisywanej wersji znamy dopiero po przejsciu - naglowek poprawiamy na koncu
+        writeHeader(outFile, 0);
+        typename Codec::BinaryWriter writer(outFile);
+        unsigned long long count = 0;
+        tree.forEachInorder([&writer, &count](int data) {
+            writer.put(data);
+            count++;
+        }, [&started]() { started.set_value(); });
+        writer.flush();
+        outFile.seekp(0);
+        writeHeader(outFile, count);
+        outFile.close();
+        if (!outFile) {
+            cerr << "Blad: Nie udalo sie zapisac pliku binarnego: " << filename << endl;
+            return false;
+        }
+        return true;
+    });
+    pinned.wait();
+    return result;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+bool BasicFileHandler<Key, Compare, Allocator, Value>::saveToText(const PersistentBST& tree, const string& filename) {
+    static_assert(is_same<Key, int>::value && is_same<Compare, less<int>>::value && !Tree::HasValue::value,
+        "PersistentBST przechowuje tylko klucze int bez wartosci");
+    ScopedTimer<statsEnabled> timer(counters.textSave);
+    ofstream outFile(filename);
+    if (!outFile) {
+        cerr << "Blad: Nie mozna otworzyc pliku do zapisu: " << filename << endl;
+        return false;
+    }
+    typename Codec::TextWriter writer(outFile);
+    tree.forEachInorder([&writer](int data) { writer.put(data); });
+    writer.flush();
+    outFile.close();
+    return static_cast<bool>(outFile);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+bool BasicFileHandler<Key, Compare, Allocator, Value>::saveToBinary(const PersistentBST& tree, const string& filename) {
+    static_assert(is_same<Key, int>::value && is_same<Compare, less<int>>::value && !Tree::HasValue::value,
+        "PersistentBST przechowuje tylko klucze int bez wartosci");
+    ScopedTimer<statsEnabled> timer(counters.binarySave);
+    ofstream outFile(filename, ios::binary);
+    if (!outFile) {
+        cerr << "Blad: Nie mozna otworzyc pliku binarnego do zapisu: " << filename << endl;
+        return false;
+    }
+
+    writeHeader(outFile, tree.getSize());
+    typename Codec::BinaryWriter writer(outFile);
+    tree.forEachInorder([&writer](int data) { writer.put(data); });
+    writer.flush();
+    outFile.close();
+    if (!outFile) {
+        cerr << "Blad: Nie udalo sie zapisac pliku binarnego: " << filename << endl;
+        return false;
+    }
+    return true;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+future<bool> BasicFileHandler<Key, Compare, Allocator, Value>::saveToBinaryAsync(const PersistentBST& tree, const string& filename) {
+    // Kopia uchwytu (O(1)) utrzymuje wezly zapisywanej wersji do konca zapisu
+    return async(launch::async, [this, version = tree, filename]() {
+        return saveToBinary(version, filename);
+    });
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+bool BasicFileHandler<Key, Compare, Allocator, Value>::loadFromBinary(PersistentBST& tree, const string& filename) {
+    static_assert(is_same<Key, int>::value && is_same<Compare, less<int>>::value && !Tree::HasValue::value,
+        "PersistentBST przechowuje tylko klucze int bez wartosci");
+    ScopedTimer<statsEnabled> timer(counters.binaryLoad);
+    ifstream inFile(filename, ios::binary);
+    if (!inFile) {
+        cerr << "Blad: Nie mozna otworzyc pliku binarnego do odczytu: " << filename << endl;
+        return false;
+    }
+
+    bool legacy = false;
+    unsigned long long count = 0;
+    if (!readHeader(inFile, filename, false, legacy, count)) {
+        return false;
+    }
+
+    vector<int> keys;
+    if (!Codec::readBinary(inFile, count, Compare(), keys)) {
+        cerr << "Blad: Plik binarny jest uszkodzony: " << filename << endl;
+        return false;
+    }
+    inFile.close();
+    tree = PersistentBST::fromSorted(keys);
+    return true;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+bool BasicFileHandler<Key, Compare, Allocator, Value>::readHeader(ifstream& inFile, const string& filename, bool allowLegacy, bool& legacy, unsigned long long& count) {
+    char header[binaryHeaderSize];
+    inFile.read(header, binaryHeaderSize);
+    legacy = !inFile || memcmp(header, binaryMagic, sizeof(binaryMagic)) != 0;
+    if (legacy) {
+        if (!allowLegacy) {
+            cerr << "Blad: Plik nie jest plikiem binarnym v2: " << filename << endl;
+            return false;
+        }
+        inFile.clear();
+        inFile.seekg(0);
+        return true;
+    }
+    if (header[4] != binaryVersion || header[5] != littleEndianMarker) {
+        cerr << "Blad: Nieobslugiwana wersja pliku binarnego: " << filename << endl;
+        return false;
+    }
+    if (header[6] != static_cast<char>(Codec::binaryKeySize) || header[7] != static_cast<char>(binaryEncoding())) {
+        cerr << "Blad: Plik binarny zawiera klucze innego typu: " << filename << endl;
+        return false;
+    }
+    count = 0;
+    for (int i = 0; i < 8; i++) {
+        count |= static_cast<unsigned long long>(static_cast<unsigned char>(header[8 + i])) << (8 * i);
+    }
+    return true;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+bool BasicFileHandler<Key, Compare, Allocator, Value>::loadFromBinary(Tree& tree, const string& filename, unsigned threads) {
+    ScopedTimer<statsEnabled> timer(counters.binaryLoad);
+    ifstream inFile(filename, ios::binary);
+    if (!inFile) {
+        cerr << "Blad: Nie mozna otworzyc pliku binarnego do odczytu: " << filename << endl;
+        return false;
+    }
+
+    bool legacy = false;
+    unsigned long long count = 0;
+    if (!readHeader(inFile, filename, true, legacy, count)) {
+        return false;
+    }
+    if (legacy) {
+        // Brak naglowka - plik w starym formacie (Preorder ze znacznikami bool)
+        tree.clear();
+        tree.root = tree.deserializeLegacy(inFile);
+        inFile.close();
+        return true;
+    }
+
+    // Wywolujemy prywatna metode pomocnicza z klasy BST (zastepuje ona zawartosc drzewa)
+    if (!tree.deserialize(inFile, count, ParallelTasks::resolveThreads(threads))) {
+        cerr << "Blad: Plik binarny jest uszkodzony: " << filename << endl;
+        return false;
+    }
+
+    inFile.close();
+    return true;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+bool BasicFileHandler<Key, Compare, Allocator, Value>::loadFromText(Tree& tree, const string& filename, unsigned threads) {
+    ScopedTimer<statsEnabled> timer(counters.textLoad);
+    // Tryb binarny: plik czytamy duzymi blokami, a biale znaki (w tym \r) obsluguje kodek kluczy
+    ifstream inFile(filename, ios::binary);
+    if (!inFile) {
+        cerr << "Blad: Nie mozna otworzyc pliku tekstowego do odczytu: " << filename << endl;
+        return false;
+    }
+
+    threads = ParallelTasks::resolveThreads(threads);
+    if (Tree::HasValue::value) {
+        // Tryb slownika: pary "klucz wartosc" czytamy sekwencyjnie, rownolegle jest tylko sortowanie i budowa
+        vector<pair<Key, Value>> entries;
+        Key key;
+        Value value;
+        while (inFile >> key && ValueCodec<Value>::readText(inFile, value)) {
+            entries.emplace_back(key, move(value));
+        }
+        inFile.close();
+        tree.bulkLoad(move(entries), threads);
+        return true;
+    }
+
+    vector<Key> numbers;
+    streamoff end = -1;
+    if (threads > 1) {
+        inFile.seekg(0, ios::end);
+        end = inFile.tellg();
+        inFile.clear(); // Nieudane przewiniecie ustawia failbit
+        if (end != -1) {
+            inFile.seekg(0);
+        }
+    }
+    if (end == -1) {
+        // Jeden watek lub strumien bez przewijania (np. potok) - czytamy blokami po kolei.
+        // Najpierw wczytujemy wszystkie liczby, a potem budujemy drzewo jednym przebiegiem.
+        // Dziala to zarowno dla pustego, jak i istniejacego drzewa.
+        Codec::readText(inFile, numbers);
+        inFile.close();
+        tree.bulkLoad(move(numbers));
+        return true;
+    }
+
+    size_t length = static_cast<size_t>(end);
+    vector<char> text(length);
+    inFile.read(text.data(), static_cast<streamsize>(length));
+    if (static_cast<size_t>(inFile.gcount()) != length) {
+        cerr << "Blad: Nie mozna odczytac calego pliku tekstowego: " << filename << endl;
+        return false;
+    }
+    inFile.close();
+
+    // Granice fragmentow przesuwamy do najblizszego bialego znaku, aby nie przeciac liczby
+    size_t chunks = max(static_cast<size_t>(1), min(static_cast<size_t>(threads) * 4, length / IntCodec::blockSize));
+    vector<size_t> bounds(chunks + 1, length);
+    bounds[0] = 0;
+    for (size_t i = 1; i < chunks; i++) {
+        size_t position = max(length * i / chunks, bounds[i - 1]);
+        while (position < length && !IntCodec::isSpace(text[position])) {
+            position++;
+        }
+        bounds[i] = position;
+    }
+
+    vector<vector<Key>> parts(chunks);
+    vector<char> complete(chunks);
+    ParallelTasks::run(chunks, threads, [&](size_t i) {
+        complete[i] = Codec::parseText(text.data() + bounds[i], text.data() + bounds[i + 1], parts[i]) ? 1 : 0;
+    });
+
+    // Jak przy czytaniu sekwencyjnym: konczymy na pierwszym nieprawidlowym tokenie
+    size_t used = 0;
+    size_t total = 0;
+    while (used < chunks) {
+        total += parts[used].size();
+        if (!complete[used++]) {
+            break;
+        }
+    }
+    numbers.reserve(total);
+    for (size_t i = 0; i < used; i++) {
+        numbers.insert(numbers.end(), parts[i].begin(), parts[i].end());
+        vector<Key>().swap(parts[i]);
+    }
+
+    tree.bulkLoad(move(numbers), threads);
+    return true;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+bool BasicFileHandler<Key, Compare, Allocator, Value>::saveSnapshot(Tree& tree, const string& filename) {
+    static_assert(is_same<Key, int>::value && is_same<Compare, less<int>>::value,
+        "Migawka TreeSnapshot przechowuje tylko klucze int w porzadku rosnacym");
+    ScopedTimer<statsEnabled> timer(counters.snapshotSave);
+    vector<Key> sorted;
+    sorted.reserve(tree.getSize());
+    // Wywolujemy prywatna metode pomocnicza z klasy BST
+    tree.collectInorder(tree.root, sorted);
+
+    if (!TreeSnapshot::write(filename, sorted)) {
+        cerr << "Blad: Nie mozna zapisac migawki: " << filename << endl;
+        return false;
+    }
+    return true;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+FileStats BasicFileHandler<Key, Compare, Allocator, Value>::getStats() const {
+    FileStats stats;
+    counters.fill(stats);
+    return stats;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Value>
+void BasicFileHandler<Key, Compare, Allocator, Value>::resetStats() {
+    counters.reset();
+}
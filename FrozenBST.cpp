@@ -0,0 +1,42 @@
+/**
+ * @file FrozenBST.cpp
+ * @brief Implementacja metod klasy FrozenBST.
+ */
+
+#include "FrozenBST.h"
+#include "EytzingerLayout.h"
+#include <cstdint>
+
+using namespace std;
+
+FrozenBST::FrozenBST(const vector<int>& sorted) : keys(nullptr), count(sorted.size()) {
+    // 64 B = 16 wartosci int; zapas pozwala przesunac poczatek tablicy na granice linii
+    const size_t lineInts = 64 / sizeof(int);
+    storage.assign(count + 1 + lineInts, 0);
+    uintptr_t address = reinterpret_cast<uintptr_t>(storage.data());
+    size_t offset = ((64 - address % 64) % 64) / sizeof(int);
+
+    int* aligned = storage.data() + offset;
+    EytzingerLayout::build(sorted, aligned);
+    keys = aligned;
+}
+
+size_t FrozenBST::getSize() const {
+    return count;
+}
+
+bool FrozenBST::contains(int data) const {
+    return EytzingerLayout::contains(keys, count, data);
+}
+
+vector<int> FrozenBST::findPath(int data) const {
+    return EytzingerLayout::findPath(keys, count, data);
+}
+
+void FrozenBST::containsBatch(const int* queries, size_t queryCount, bool* found) const {
+    EytzingerLayout::containsBatch(keys, count, queries, queryCount, found);
+}
+
+void FrozenBST::lowerBoundBatch(const int* queries, size_t queryCount, int* values, bool* found) const {
+    EytzingerLayout::lowerBoundBatch(keys, count, queries, queryCount, values, found);
+}
@@ -0,0 +1,78 @@
+/**
+ * @file FrozenBST.h
+ * @brief Definicja klasy FrozenBST - niezmiennej, przyjaznej dla pamieci podrecznej kopii drzewa.
+ * * Powstaje przez "zamrozenie" drzewa BST (BST::freeze). Wartosci leza w jednej
+ * ciaglej tablicy w ukladzie Eytzingera, wiec przeszukiwanie nie skacze po
+ * wskaznikach, a kolejne poziomy drzewa mozna pobierac z wyprzedzeniem.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Statyczny indeks wartosci drzewa, zoptymalizowany pod szybkie wyszukiwanie.
+ * * Nie obsluguje modyfikacji - po zmianach w BST nalezy wywolac BST::freeze() ponownie.
+ * Obiekt mozna przenosic, ale nie kopiowac.
+ */
+class FrozenBST {
+private:
+    vector<int> storage; ///< Pamiec tablicy (z zapasem na wyrownanie).
+    const int* keys; ///< Tablica w ukladzie Eytzingera, wyrownana do 64 B (wewnatrz storage).
+    size_t count; ///< Liczba wartosci.
+
+public:
+    /**
+     * @brief Tworzy indeks z posortowanych wartosci.
+     * @param sorted Wartosci posortowane rosnaco, bez duplikatow.
+     */
+    explicit FrozenBST(const vector<int>& sorted);
+
+    FrozenBST(FrozenBST&&) = default;
+    FrozenBST& operator=(FrozenBST&&) = default;
+    FrozenBST(const FrozenBST&) = delete;
+    FrozenBST& operator=(const FrozenBST&) = delete;
+
+    /**
+     * @brief Zwraca liczbe wartosci w indeksie.
+     * @return Liczba wartosci.
+     */
+    size_t getSize() const;
+
+    /**
+     * @brief Sprawdza, czy wartosc wystepuje w indeksie (wyszukiwanie bezskokowe).
+     * @param data Szukana wartosc.
+     * @return true jesli wartosc zostala znaleziona.
+     */
+    bool contains(int data) const;
+
+    /**
+     * @brief Wyszukuje sciezke od korzenia do wartosci w drzewie indeksu.
+     * * Sciezka dotyczy zrownowazonego drzewa indeksu, a nie ksztaltu zrodlowego BST.
+     * @param data Wartosc do znalezienia.
+     * @return Wektor wartosci na sciezce; pusty, jesli elementu nie znaleziono.
+     */
+    vector<int> findPath(int data) const;
+
+    /**
+     * @brief Sprawdza przynaleznosc wielu wartosci naraz, bez alokacji pamieci.
+     * * Zapytania sa przetwarzane grupami schodzacymi po drzewie rownolegle
+     * - patrz EytzingerLayout::containsBatch.
+     * @param queries Szukane wartosci.
+     * @param queryCount Liczba zapytan.
+     * @param found Tablica wynikow (queryCount elementow).
+     */
+    void containsBatch(const int* queries, size_t queryCount, bool* found) const;
+
+    /**
+     * @brief Wyznacza dla wielu zapytan najmniejsza wartosc >= zapytanie, bez alokacji pamieci.
+     * @param queries Szukane wartosci.
+     * @param queryCount Liczba zapytan.
+     * @param values Tablica wynikow: znaleziona wartosc (0, gdy found[i] == false).
+     * @param found Tablica wynikow: czy taka wartosc istnieje.
+     */
+    void lowerBoundBatch(const int* queries, size_t queryCount, int* values, bool* found) const;
+};
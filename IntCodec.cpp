@@ -0,0 +1,138 @@
+/**
+ * @file IntCodec.cpp
+ * @brief Implementacja metod klasy IntCodec.
+ */
+
+#include "IntCodec.h"
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+using namespace std;
+
+namespace {
+    /// @brief Wspolna implementacja format() dla int i long long.
+    template <typename Integer>
+    char* formatInteger(Integer value, char* out) {
+        // Liczymy na typie bez znaku, zeby poprawnie obsluzyc wartosc minimalna
+        typedef typename make_unsigned<Integer>::type Unsigned;
+        Unsigned magnitude = static_cast<Unsigned>(value);
+        if (value < 0) {
+            *out++ = '-';
+            magnitude = Unsigned(0) - magnitude;
+        }
+
+        char digits[numeric_limits<Unsigned>::digits10 + 1];
+        int count = 0;
+        do {
+            digits[count++] = static_cast<char>('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude != 0);
+
+        while (count > 0) {
+            *out++ = digits[--count];
+        }
+        return out;
+    }
+
+    /// @brief Wspolna implementacja parse() dla int i long long.
+    template <typename Integer>
+    bool parseInteger(const char* begin, const char* end, vector<Integer>& out) {
+        typedef typename make_unsigned<Integer>::type Unsigned;
+        const char* p = begin;
+        while (true) {
+            while (p != end && IntCodec::isSpace(*p)) {
+                ++p;
+            }
+            if (p == end) {
+                return true;
+            }
+
+            bool negative = false;
+            if (*p == '-' || *p == '+') {
+                negative = (*p == '-');
+                ++p;
+            }
+            if (p == end || *p < '0' || *p > '9') {
+                return false; // Token nie jest liczba
+            }
+
+            // Granica modulu: wartosc maksymalna lub o jeden wieksza dla liczb ujemnych
+            const Unsigned limit = negative
+                ? static_cast<Unsigned>(numeric_limits<Integer>::max()) + 1
+                : static_cast<Unsigned>(numeric_limits<Integer>::max());
+            Unsigned magnitude = 0;
+            while (p != end && *p >= '0' && *p <= '9') {
+                unsigned digit = static_cast<unsigned>(*p - '0');
+                if (magnitude > (limit - digit) / 10) {
+                    return false; // Przepelnienie, tak jak dla operatora >>
+                }
+                magnitude = magnitude * 10 + digit;
+                ++p;
+            }
+
+            out.push_back(negative
+                ? static_cast<Integer>(Unsigned(0) - magnitude)
+                : static_cast<Integer>(magnitude));
+        }
+    }
+
+    /// @brief Wspolna implementacja readAll() dla int i long long.
+    template <typename Integer>
+    void readAllIntegers(istream& in, vector<Integer>& out) {
+        vector<char> buffer(IntCodec::blockSize);
+        size_t carry = 0; // Liczba bajtow niedokonczonego tokenu z poprzedniego bloku
+
+        while (true) {
+            in.read(buffer.data() + carry, static_cast<streamsize>(buffer.size() - carry));
+            size_t length = carry + static_cast<size_t>(in.gcount());
+            bool lastBlock = !in;
+
+            if (lastBlock) {
+                parseInteger(buffer.data(), buffer.data() + length, out);
+                return;
+            }
+
+            // Parsujemy tylko do ostatniego bialego znaku - dalej moze byc przecieta liczba
+            size_t complete = length;
+            while (complete > 0 && !IntCodec::isSpace(buffer[complete - 1])) {
+                complete--;
+            }
+            if (complete == 0) {
+                // Caly blok to jeden token - na pewno nie jest poprawna liczba
+                parseInteger(buffer.data(), buffer.data() + length, out);
+                return;
+            }
+            if (!parseInteger(buffer.data(), buffer.data() + complete, out)) {
+                return;
+            }
+
+            carry = length - complete;
+            memmove(buffer.data(), buffer.data() + complete, carry);
+        }
+    }
+}
+
+char* IntCodec::format(int value, char* out) {
+    return formatInteger(value, out);
+}
+
+char* IntCodec::format(long long value, char* out) {
+    return formatInteger(value, out);
+}
+
+bool IntCodec::parse(const char* begin, const char* end, vector<int>& out) {
+    return parseInteger(begin, end, out);
+}
+
+bool IntCodec::parse(const char* begin, const char* end, vector<long long>& out) {
+    return parseInteger(begin, end, out);
+}
+
+void IntCodec::readAll(istream& in, vector<int>& out) {
+    readAllIntegers(in, out);
+}
+
+void IntCodec::readAll(istream& in, vector<long long>& out) {
+    readAllIntegers(in, out);
+}
@@ -0,0 +1,91 @@
+/**
+ * @file IntCodec.h
+ * @brief Definicja klasy IntCodec - szybkiego kodeka liczb calkowitych w formacie tekstowym.
+ * * Zastepuje strumieniowe operatory >> i << (ktore uwzgledniaja locale i sa wolne)
+ * recznie napisanym parserem i formatowaniem dzialajacym na duzych blokach pamieci.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <istream>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Zestaw statycznych metod do czytania i zapisywania liczb int i long long jako tekstu.
+ * * Format jest identyczny jak przy uzyciu strumieni: liczby dziesietne z opcjonalnym
+ * znakiem, oddzielone bialymi znakami. Parsowanie konczy sie na pierwszym
+ * nieprawidlowym tokenie lub przepelnieniu, tak jak petla `while (in >> number)`.
+ */
+class IntCodec {
+public:
+    /// @brief Maksymalna liczba znakow zapisu jednej liczby int (znak + 10 cyfr).
+    static const size_t maxChars = 11;
+
+    /// @brief Maksymalna liczba znakow zapisu jednej liczby long long (znak + 19 cyfr).
+    static const size_t maxLongChars = 20;
+
+    /// @brief Rozmiar bloku, jakim czytamy plik w readAll().
+    static const size_t blockSize = 1 << 20;
+
+    /**
+     * @brief Sprawdza, czy znak jest bialym znakiem (w sensie isspace dla locale "C").
+     * @param c Sprawdzany znak.
+     * @return true dla spacji, tabulacji i znakow konca linii.
+     */
+    static bool isSpace(char c) {
+        return c == ' ' || (c >= '\t' && c <= '\r');
+    }
+
+    /**
+     * @brief Zapisuje liczbe w postaci dziesietnej.
+     * @param value Liczba do zapisania.
+     * @param out Bufor wyjsciowy (musi miec miejsce na co najmniej maxChars znakow).
+     * @return Wskaznik za ostatnim zapisanym znakiem.
+     */
+    static char* format(int value, char* out);
+
+    /**
+     * @brief Zapisuje liczbe 64-bitowa w postaci dziesietnej.
+     * @param value Liczba do zapisania.
+     * @param out Bufor wyjsciowy (musi miec miejsce na co najmniej maxLongChars znakow).
+     * @return Wskaznik za ostatnim zapisanym znakiem.
+     */
+    static char* format(long long value, char* out);
+
+    /**
+     * @brief Parsuje wszystkie liczby z fragmentu tekstu i dopisuje je do wektora.
+     * @param begin Poczatek tekstu.
+     * @param end Koniec tekstu (tekst nie musi konczyc sie bialym znakiem).
+     * @param out Wektor, do ktorego trafiaja odczytane liczby.
+     * @return true jesli caly fragment zostal odczytany, false jesli napotkano
+     * nieprawidlowy token (liczby sprzed niego zostaja w wektorze).
+     */
+    static bool parse(const char* begin, const char* end, vector<int>& out);
+
+    /**
+     * @brief Wersja parse() dla liczb 64-bitowych.
+     * @param begin Poczatek tekstu.
+     * @param end Koniec tekstu.
+     * @param out Wektor, do ktorego trafiaja odczytane liczby.
+     * @return true jesli caly fragment zostal odczytany.
+     */
+    static bool parse(const char* begin, const char* end, vector<long long>& out);
+
+    /**
+     * @brief Czyta wszystkie liczby ze strumienia, blokami po blockSize bajtow.
+     * * Liczba przecieta granica bloku jest przenoszona na poczatek kolejnego bloku.
+     * @param in Strumien wejsciowy (najlepiej otwarty w trybie binarnym).
+     * @param out Wektor, do ktorego trafiaja odczytane liczby.
+     */
+    static void readAll(istream& in, vector<int>& out);
+
+    /**
+     * @brief Wersja readAll() dla liczb 64-bitowych.
+     * @param in Strumien wejsciowy.
+     * @param out Wektor, do ktorego trafiaja odczytane liczby.
+     */
+    static void readAll(istream& in, vector<long long>& out);
+};
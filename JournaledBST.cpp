@@ -0,0 +1,526 @@
+/**
+ * @file JournaledBST.cpp
+ * @brief Implementacja metod klasy JournaledBST.
+ */
+
+#include "JournaledBST.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <utility>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace {
+    const char journalMagic[4] = { 'B', 'S', 'T', 'J' };
+    const char journalVersion = 1;
+
+    /// @brief Suma kontrolna rekordu (obracany XOR bajtow) - wykrywa rekordy uciete i nadpisane smieciami.
+    unsigned char checksum(const char* data, size_t length) {
+        unsigned char sum = 0x5A;
+        for (size_t i = 0; i < length; i++) {
+            sum = static_cast<unsigned char>(((sum << 1) | (sum >> 7)) ^ static_cast<unsigned char>(data[i]));
+        }
+        return sum;
+    }
+
+    /// @brief Wczytuje caly plik do pamieci.
+    bool readWholeFile(const string& filename, vector<char>& data) {
+        ifstream in(filename, ios::binary);
+        if (!in) {
+            return false;
+        }
+        data.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+        return !in.bad();
+    }
+}
+
+JournaledBST::JournaledBST(unsigned commitIntervalMs, size_t compactionThreshold)
+    : opened(false), appendedSequence(0), durableSequence(0), stopping(false), failed(false),
+    compactionRequested(false), syncWaiters(0), journal(), journalOpen(false), journalBytes(0),
+    commitIntervalMs(commitIntervalMs), compactionThreshold(compactionThreshold) {}
+
+JournaledBST::~JournaledBST() {
+    close();
+}
+
+// --- Pliki ---
+
+bool JournaledBST::openFile(const string& filename, bool truncate, FileHandle& handle) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+        truncate ? CREATE_ALWAYS : OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER zero;
+    zero.QuadPart = 0;
+    if (!SetFilePointerEx(file, zero, nullptr, FILE_END)) {
+        CloseHandle(file);
+        return false;
+    }
+    handle = file;
+    return true;
+#else
+    int descriptor = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_APPEND | (truncate ? O_TRUNC : 0), 0644);
+    if (descriptor < 0) {
+        return false;
+    }
+    handle = descriptor;
+    return true;
+#endif
+}
+
+bool JournaledBST::writeFile(FileHandle handle, const char* data, size_t length) {
+    while (length > 0) {
+#ifdef _WIN32
+        DWORD chunk = static_cast<DWORD>(min(length, static_cast<size_t>(1) << 30));
+        DWORD written = 0;
+        if (!WriteFile(static_cast<HANDLE>(handle), data, chunk, &written, nullptr) || written == 0) {
+            return false;
+        }
+#else
+        ssize_t written = ::write(handle, data, length);
+        if (written <= 0) {
+            return false;
+        }
+#endif
+        data += written;
+        length -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+bool JournaledBST::syncFile(FileHandle handle) {
+#ifdef _WIN32
+    return FlushFileBuffers(static_cast<HANDLE>(handle)) != 0;
+#else
+    return fsync(handle) == 0;
+#endif
+}
+
+void JournaledBST::closeFile(FileHandle handle) {
+#ifdef _WIN32
+    CloseHandle(static_cast<HANDLE>(handle));
+#else
+    ::close(handle);
+#endif
+}
+
+bool JournaledBST::syncDirectory(const string& filename) {
+#ifdef _WIN32
+    (void)filename;
+    return true;
+#else
+    string directory = filesystem::path(filename).parent_path().string();
+    int descriptor = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY | O_DIRECTORY);
+    if (descriptor < 0) {
+        return false;
+    }
+    bool ok = fsync(descriptor) == 0;
+    ::close(descriptor);
+    return ok;
+#endif
+}
+
+// --- Dziennik ---
+
+void JournaledBST::append(Operation op, int data) {
+    if (!opened || failed) {
+        return;
+    }
+    char record[recordSize];
+    record[0] = static_cast<char>(op);
+    unsigned int bits = static_cast<unsigned int>(data);
+    for (int i = 0; i < 4; i++) {
+        record[1 + i] = static_cast<char>((bits >> (8 * i)) & 0xFF);
+    }
+    record[5] = static_cast<char>(checksum(record, recordSize - 1));
+    pending.insert(pending.end(), record, record + recordSize);
+    appendedSequence++;
+    if (pending.size() >= groupCommitBytes) {
+        flushWake.notify_one();
+    }
+}
+
+bool JournaledBST::replay(const string& filename) {
+    vector<char> data;
+    if (!readWholeFile(filename, data)) {
+        cerr << "Blad: Nie mozna odczytac dziennika: " << filename << endl;
+        return false;
+    }
+    error_code error;
+    if (data.size() < journalHeaderSize) {
+        // Awaria w trakcie tworzenia dziennika - nie ma w nim zadnych rekordow
+        filesystem::resize_file(filename, 0, error);
+        return !error;
+    }
+    if (memcmp(data.data(), journalMagic, sizeof(journalMagic)) != 0 || data[4] != journalVersion) {
+        cerr << "Blad: Plik nie jest dziennikiem drzewa lub ma nieobslugiwana wersje: " << filename << endl;
+        return false;
+    }
+
+    size_t position = journalHeaderSize;
+    while (position + recordSize <= data.size()) {
+        const char* record = data.data() + position;
+        if (static_cast<unsigned char>(record[5]) != checksum(record, recordSize - 1)) {
+            break;
+        }
+        unsigned int bits = 0;
+        for (int i = 0; i < 4; i++) {
+            bits |= static_cast<unsigned int>(static_cast<unsigned char>(record[1 + i])) << (8 * i);
+        }
+        int key = static_cast<int>(bits);
+        switch (record[0]) {
+        case OpInsert: tree.insert(key); break;
+        case OpRemove: tree.remove(key); break;
+        case OpClear: tree.clear(); break;
+        default: break; // Nieznana operacja przy poprawnej sumie - pomijamy
+        }
+        position += recordSize;
+    }
+
+    if (position != data.size()) {
+        // Uciety lub uszkodzony koniec (awaria w trakcie zapisu) - kolejne rekordy dopiszemy za ostatnim dobrym
+        cerr << "Uwaga: Obcinanie uszkodzonego konca dziennika " << filename << " ("
+            << (data.size() - position) << " B)" << endl;
+        filesystem::resize_file(filename, position, error);
+        if (error) {
+            cerr << "Blad: Nie mozna obciac dziennika: " << filename << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool JournaledBST::startJournal() {
+    if (!openFile(basePath + ".wal", true, journal)) {
+        return false;
+    }
+    char header[journalHeaderSize] = {};
+    memcpy(header, journalMagic, sizeof(journalMagic));
+    header[4] = journalVersion;
+    // Bez utrwalonego wpisu katalogu rekordy zgloszone jako trwale moglyby zniknac razem z plikiem
+    if (!writeFile(journal, header, journalHeaderSize) || !syncFile(journal) || !syncDirectory(basePath + ".wal")) {
+        // Dziennik uznajemy za otwarty dopiero z trwalym naglowkiem - inaczej close() i destruktor
+        // (ktore po nieudanym open() nic nie robia) nie zamknelyby uchwytu
+        closeFile(journal);
+        return false;
+    }
+    journalOpen = true;
+    journalBytes = journalHeaderSize;
+    return true;
+}
+
+bool JournaledBST::writeJournal(const vector<char>& records) {
+    if (!journalOpen || !writeFile(journal, records.data(), records.size()) || !syncFile(journal)) {
+        return false;
+    }
+    journalBytes += records.size();
+    return true;
+}
+
+bool JournaledBST::flush() {
+    lock_guard<mutex> fileLock(fileMutex);
+    unsigned long long sequence;
+    {
+        lock_guard<mutex> lock(treeMutex);
+        flushBuffer.clear();
+        flushBuffer.swap(pending);
+        sequence = appendedSequence;
+    }
+
+    // Jeden zapis i jeden fsync dla wszystkich rekordow zebranych od poprzedniego razu
+    bool ok = flushBuffer.empty() || writeJournal(flushBuffer);
+    if (!ok) {
+        fail("Nie mozna zapisac dziennika: " + basePath + ".wal");
+        return false;
+    }
+    {
+        lock_guard<mutex> lock(treeMutex);
+        durableSequence = sequence;
+        if (journalBytes >= compactionThreshold && !compactionRequested) {
+            compactionRequested = true;
+            compactionWake.notify_one();
+        }
+    }
+    durableChanged.notify_all();
+    return true;
+}
+
+bool JournaledBST::retireJournal() {
+    if (journalOpen) {
+        closeFile(journal);
+        journalOpen = false;
+    }
+    string current = basePath + ".wal";
+    string old = basePath + ".wal.old";
+    error_code error;
+    if (!filesystem::exists(old, error)) {
+        filesystem::rename(current, old, error);
+        return !error && syncDirectory(old);
+    }
+
+    // Poprzednia migawka nie powstala - dopisujemy rekordy do starego dziennika zamiast go nadpisywac
+    vector<char> data;
+    if (!readWholeFile(current, data)) {
+        return false;
+    }
+    if (data.size() > journalHeaderSize) {
+        FileHandle file;
+        if (!openFile(old, false, file)) {
+            return false;
+        }
+        bool ok = writeFile(file, data.data() + journalHeaderSize, data.size() - journalHeaderSize) && syncFile(file);
+        closeFile(file);
+        if (!ok) {
+            return false;
+        }
+    }
+    return filesystem::remove(current, error) && !error && syncDirectory(current);
+}
+
+void JournaledBST::flushLoop() {
+    unique_lock<mutex> lock(treeMutex);
+    while (true) {
+        flushWake.wait_for(lock, chrono::milliseconds(commitIntervalMs), [this]() {
+            return stopping || (!pending.empty() && (syncWaiters > 0 || pending.size() >= groupCommitBytes));
+        });
+        bool stop = stopping;
+        bool work = !pending.empty();
+        lock.unlock();
+        if (work) {
+            flush();
+        }
+        lock.lock();
+        if (stop) {
+            break;
+        }
+    }
+}
+
+void JournaledBST::compactLoop() {
+    unique_lock<mutex> lock(treeMutex);
+    while (true) {
+        compactionWake.wait(lock, [this]() { return stopping || compactionRequested; });
+        if (stopping) {
+            break;
+        }
+        lock.unlock();
+        compact();
+        lock.lock();
+        compactionRequested = false;
+    }
+}
+
+void JournaledBST::fail(const string& message) {
+    {
+        lock_guard<mutex> lock(treeMutex);
+        failed = true;
+        pending.clear();
+    }
+    durableChanged.notify_all();
+    cerr << "Blad: " << message << endl;
+}
+
+// --- Metody publiczne ---
+
+bool JournaledBST::open(const string& path) {
+    close();
+    basePath = path;
+    tree.clear();
+
+    error_code error;
+    filesystem::remove(basePath + ".bin.tmp", error); // Migawka przerwana przez awarie
+    if (filesystem::exists(basePath + ".bin", error) && !fileHandler.loadFromBinary(tree, basePath + ".bin")) {
+        return false;
+    }
+    bool retired = filesystem::exists(basePath + ".wal.old", error);
+    if (retired && !replay(basePath + ".wal.old")) {
+        return false;
+    }
+    string current = basePath + ".wal";
+    if (filesystem::exists(current, error) && !replay(current)) {
+        return false;
+    }
+
+    {
+        lock_guard<mutex> fileLock(fileMutex);
+        unsigned long long size = filesystem::exists(current, error) ? filesystem::file_size(current, error) : 0;
+        if (size >= journalHeaderSize) {
+            if (!openFile(current, false, journal)) {
+                cerr << "Blad: Nie mozna otworzyc dziennika: " << current << endl;
+                return false;
+            }
+            journalOpen = true;
+            journalBytes = size;
+        }
+        else if (!startJournal()) {
+            cerr << "Blad: Nie mozna utworzyc dziennika: " << current << endl;
+            return false;
+        }
+    }
+
+    {
+        lock_guard<mutex> lock(treeMutex);
+        pending.clear();
+        appendedSequence = 0;
+        durableSequence = 0;
+        stopping = false;
+        failed = false;
+        // Przerwana kompakcja (jest P.wal.old) lub duzy dziennik - od razu zapisujemy nowa migawke
+        compactionRequested = retired || journalBytes >= compactionThreshold;
+        opened = true;
+    }
+    flusher = thread(&JournaledBST::flushLoop, this);
+    compactor = thread(&JournaledBST::compactLoop, this);
+    return true;
+}
+
+bool JournaledBST::close() {
+    {
+        lock_guard<mutex> lock(treeMutex);
+        if (!opened) {
+            return !failed;
+        }
+        stopping = true;
+    }
+    flushWake.notify_all();
+    compactionWake.notify_all();
+    flusher.join();
+    compactor.join();
+    flush(); // Rekordy dodane w trakcie zatrzymywania watkow
+
+    lock_guard<mutex> fileLock(fileMutex);
+    if (journalOpen) {
+        closeFile(journal);
+        journalOpen = false;
+    }
+    lock_guard<mutex> lock(treeMutex);
+    opened = false;
+    durableChanged.notify_all();
+    return !failed;
+}
+
+void JournaledBST::insert(int data) {
+    lock_guard<mutex> lock(treeMutex);
+    size_t before = tree.getSize();
+    tree.insert(data);
+    if (tree.getSize() != before) {
+        append(OpInsert, data); // Operacje bez zmian nie trafiaja do dziennika
+    }
+}
+
+void JournaledBST::remove(int data) {
+    lock_guard<mutex> lock(treeMutex);
+    size_t before = tree.getSize();
+    tree.remove(data);
+    if (tree.getSize() != before) {
+        append(OpRemove, data);
+    }
+}
+
+void JournaledBST::clear() {
+    lock_guard<mutex> lock(treeMutex);
+    if (tree.getSize() != 0) {
+        tree.clear();
+        append(OpClear, 0);
+    }
+}
+
+bool JournaledBST::contains(int data) const {
+    lock_guard<mutex> lock(treeMutex);
+    return tree.contains(data);
+}
+
+size_t JournaledBST::getSize() const {
+    lock_guard<mutex> lock(treeMutex);
+    return tree.getSize();
+}
+
+bool JournaledBST::sync() {
+    unique_lock<mutex> lock(treeMutex);
+    if (!opened) {
+        return false;
+    }
+    unsigned long long target = appendedSequence;
+    syncWaiters++;
+    flushWake.notify_one();
+    durableChanged.wait(lock, [this, target]() { return durableSequence >= target || failed || !opened; });
+    syncWaiters--;
+    return !failed && durableSequence >= target;
+}
+
+bool JournaledBST::compact() {
+    lock_guard<mutex> compactionLock(compactionMutex);
+    vector<int> keys;
+    {
+        lock_guard<mutex> fileLock(fileMutex);
+        unsigned long long sequence;
+        {
+            lock_guard<mutex> lock(treeMutex);
+            if (!opened || failed) {
+                return false;
+            }
+            // Jedyny moment, w ktorym kompakcja blokuje pisarzy: kopia kluczy i zaleglych rekordow
+            keys.reserve(tree.getSize());
+            keys.assign(tree.begin(), tree.end());
+            flushBuffer.clear();
+            flushBuffer.swap(pending);
+            sequence = appendedSequence;
+        }
+
+        // Zalegle rekordy koncza stary dziennik, kolejne zmiany trafia juz do nowego
+        bool ok = (flushBuffer.empty() || writeJournal(flushBuffer)) && retireJournal() && startJournal();
+        if (!ok) {
+            fail("Nie mozna rozpoczac nowego dziennika: " + basePath + ".wal");
+            return false;
+        }
+        {
+            lock_guard<mutex> lock(treeMutex);
+            durableSequence = sequence;
+        }
+        durableChanged.notify_all();
+    }
+
+    // Migawke zapisujemy bez blokad; do czasu podmiany pliku stan odtwarza P.wal.old
+    BST copy;
+    copy.bulkLoad(move(keys));
+    string temporary = basePath + ".bin.tmp";
+    FileHandle file;
+    bool ok = fileHandler.saveToBinary(copy, temporary) && openFile(temporary, false, file);
+    if (ok) {
+        ok = syncFile(file);
+        closeFile(file);
+    }
+    error_code error;
+    if (ok) {
+        filesystem::rename(temporary, basePath + ".bin", error);
+        // P.wal.old mozna usunac dopiero, gdy nowa nazwa migawki przetrwa awarie
+        ok = !error && syncDirectory(temporary);
+    }
+    if (!ok) {
+        fail("Nie mozna zapisac migawki: " + basePath + ".bin");
+        return false;
+    }
+    filesystem::remove(basePath + ".wal.old", error);
+    return true;
+}
+
+unsigned long long JournaledBST::getJournalBytes() {
+    lock_guard<mutex> fileLock(fileMutex);
+    return journalBytes;
+}
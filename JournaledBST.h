@@ -0,0 +1,259 @@
+/**
+ * @file JournaledBST.h
+ * @brief Definicja klasy JournaledBST - drzewa BST utrwalanego dziennikiem zmian (write-ahead log).
+ * * Zamiast zapisywac cale drzewo po kazdej zmianie, kazde insert/remove dopisuje krotki
+ * rekord na koniec dziennika. Rekordy sa zapisywane i utrwalane (fsync) grupami przez
+ * watek w tle, wiec koszt utrwalenia jest proporcjonalny do liczby zmian, a nie do
+ * rozmiaru drzewa. Gdy dziennik urosnie, drugi watek w tle zapisuje nowa migawke
+ * (plik binarny FileHandler) i zaczyna pusty dziennik.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BST.h"
+#include "FileHandler.h"
+
+using namespace std;
+
+/**
+ * @brief Drzewo BST (klucze int) z trwaloscia oparta na migawce i dzienniku zmian.
+ * * Pliki (dla sciezki bazowej P):
+ *   - P.bin - migawka w formacie binarnym FileHandler,
+ *   - P.wal - dziennik: naglowek "BSTJ" + wersja (8 bajtow), potem rekordy po 6 bajtow:
+ *     operacja (1 = insert, 2 = remove, 3 = clear), klucz (int32, little-endian), suma kontrolna,
+ *   - P.wal.old - dziennik sprzed kompakcji, istniejacy tylko do zapisania nowej migawki.
+ * Odtworzenie: wczytanie migawki, a potem odtworzenie P.wal.old (jesli jest) i P.wal.
+ * Powtorne odtworzenie rekordow juz zawartych w migawce daje ten sam stan, wiec awaria
+ * w dowolnym momencie kompakcji nie gubi ani nie przestawia zmian. Uciety lub uszkodzony
+ * koniec dziennika (awaria w trakcie zapisu) jest przy odtwarzaniu obcinany.
+ * Wszystkie metody sa bezpieczne dla wielu watkow (drzewo chroni jeden muteks).
+ */
+class JournaledBST {
+private:
+    BST tree; ///< Aktualny stan drzewa.
+    FileHandler fileHandler; ///< Zapis i odczyt migawek.
+    string basePath; ///< Sciezka bazowa plikow (bez rozszerzen).
+    bool opened; ///< Czy open() sie powiodlo i watki w tle dzialaja.
+
+    mutable mutex treeMutex; ///< Chroni drzewo, bufor pending i liczniki sekwencji.
+    vector<char> pending; ///< Rekordy czekajace na zapis do dziennika.
+    unsigned long long appendedSequence; ///< Numer ostatniego rekordu dodanego do pending.
+    unsigned long long durableSequence; ///< Numer ostatniego rekordu utrwalonego na dysku.
+    bool stopping; ///< Czy watki w tle maja sie zakonczyc.
+    bool failed; ///< Czy wystapil blad zapisu dziennika lub migawki.
+    bool compactionRequested; ///< Czy watek kompakcji ma zapisac nowa migawke.
+    condition_variable flushWake; ///< Budzi watek zapisu (duzy bufor, sync(), zamkniecie).
+    condition_variable durableChanged; ///< Budzi watki czekajace w sync().
+    condition_variable compactionWake; ///< Budzi watek kompakcji.
+
+    size_t syncWaiters; ///< Liczba watkow czekajacych w sync().
+
+#ifdef _WIN32
+    typedef void* FileHandle; ///< Uchwyt pliku (HANDLE).
+#else
+    typedef int FileHandle; ///< Deskryptor pliku.
+#endif
+
+    mutex fileMutex; ///< Chroni plik dziennika i flushBuffer; zawsze brany przed treeMutex.
+    FileHandle journal; ///< Otwarty plik P.wal (wazny, gdy journalOpen).
+    bool journalOpen; ///< Czy plik dziennika jest otwarty.
+    unsigned long long journalBytes; ///< Rozmiar pliku P.wal.
+    vector<char> flushBuffer; ///< Rekordy zabrane z pending do zapisu (zamieniany z pending, aby nie alokowac).
+
+    mutex compactionMutex; ///< Nie pozwala na dwie kompakcje jednoczesnie.
+
+    unsigned commitIntervalMs; ///< Maksymalny czas oczekiwania rekordu na zapis.
+    size_t compactionThreshold; ///< Rozmiar dziennika, po ktorym zapisywana jest nowa migawka.
+
+    thread flusher; ///< Watek zapisujacy rekordy grupami (group commit).
+    thread compactor; ///< Watek zapisujacy migawki w tle.
+
+    /// @brief Rozmiar jednego rekordu dziennika w bajtach.
+    static const size_t recordSize = 6;
+
+    /// @brief Rozmiar naglowka dziennika w bajtach.
+    static const size_t journalHeaderSize = 8;
+
+    /// @brief Rozmiar bufora pending, po ktorym watek zapisu jest budzony przed uplywem commitIntervalMs.
+    static const size_t groupCommitBytes = 1 << 16;
+
+    /// @brief Kody operacji w rekordach dziennika.
+    enum Operation : unsigned char { OpInsert = 1, OpRemove = 2, OpClear = 3 };
+
+    /**
+     * @brief Otwiera plik do dopisywania na koncu.
+     * @param filename Nazwa pliku (jest tworzony, jesli nie istnieje).
+     * @param truncate Czy usunac dotychczasowa zawartosc.
+     * @param handle Uchwyt otwartego pliku.
+     * @return true jesli sie powiodlo.
+     */
+    static bool openFile(const string& filename, bool truncate, FileHandle& handle);
+
+    /**
+     * @brief Zapisuje dane na koncu pliku.
+     * @param handle Uchwyt pliku z openFile().
+     * @param data Dane.
+     * @param length Liczba bajtow.
+     * @return true jesli zapisano wszystkie bajty.
+     */
+    static bool writeFile(FileHandle handle, const char* data, size_t length);
+
+    /**
+     * @brief Wymusza zapis danych pliku na dysk (fsync / FlushFileBuffers).
+     * @param handle Uchwyt pliku z openFile().
+     * @return true jesli sie powiodlo.
+     */
+    static bool syncFile(FileHandle handle);
+
+    /// @brief Zamyka plik otwarty przez openFile().
+    static void closeFile(FileHandle handle);
+
+    /**
+     * @brief Utrwala wpisy katalogu zawierajacego plik (utworzenie, zmiana nazwy, usuniecie).
+     * * Na POSIX fsync pliku nie utrwala jego wpisu w katalogu - po awarii zasilania nowy
+     * lub przemianowany plik moglby zniknac. Na Windows NTFS utrwala zmiany katalogow
+     * we wlasnym dzienniku, wiec metoda nic nie robi.
+     * @param filename Nazwa pliku w utrwalanym katalogu.
+     * @return true jesli sie powiodlo.
+     */
+    static bool syncDirectory(const string& filename);
+
+    /**
+     * @brief Dopisuje rekord do bufora pending (wymaga treeMutex).
+     * @param op Kod operacji.
+     * @param data Klucz (0 dla clear).
+     */
+    void append(Operation op, int data);
+
+    /**
+     * @brief Odtwarza rekordy z pliku dziennika, obcinajac uszkodzony koniec.
+     * @param filename Plik dziennika.
+     * @return false jesli pliku nie da sie odczytac lub ma bledny naglowek.
+     */
+    bool replay(const string& filename);
+
+    /**
+     * @brief Otwiera pusty plik dziennika P.wal i zapisuje jego naglowek (wymaga fileMutex).
+     * * Przy bledzie zapisu plik jest zamykany, a journalOpen pozostaje false.
+     * @return true jesli sie powiodlo.
+     */
+    bool startJournal();
+
+    /**
+     * @brief Zapisuje rekordy do dziennika i wymusza ich zapis na dysk (wymaga fileMutex).
+     * @param records Rekordy do zapisania.
+     * @return true jesli zapis sie powiodl.
+     */
+    bool writeJournal(const vector<char>& records);
+
+    /**
+     * @brief Przenosi rekordy z pending do dziennika i oglasza ich utrwalenie.
+     * @return true jesli zapis sie powiodl.
+     */
+    bool flush();
+
+    /// @brief Petla watku zapisu: co commitIntervalMs (lub na zadanie) wykonuje flush().
+    void flushLoop();
+
+    /// @brief Petla watku kompakcji: czeka na compactionRequested i wykonuje compact().
+    void compactLoop();
+
+    /**
+     * @brief Konczy biezacy dziennik i przenosi jego rekordy do P.wal.old (wymaga fileMutex).
+     * * Jesli P.wal.old juz istnieje (poprzednia kompakcja nie zapisala migawki), rekordy sa
+     * do niego dopisywane, aby nie zgubic zmian, ktorych nie ma jeszcze w zadnej migawce.
+     * @return true jesli sie powiodlo.
+     */
+    bool retireJournal();
+
+    /**
+     * @brief Oznacza blad i wypisuje komunikat na cerr (nie moze byc wywolana pod treeMutex).
+     * * Po bledzie kolejne zmiany nie sa juz zapisywane do dziennika, a sync() zwraca false;
+     * aby znow utrwalac zmiany, nalezy ponownie wywolac open().
+     * @param message Opis bledu.
+     */
+    void fail(const string& message);
+
+public:
+    /**
+     * @brief Konstruktor, tworzy zamkniete, puste drzewo.
+     * @param commitIntervalMs Maksymalny czas (w ms), po jakim zmiana trafia na dysk.
+     * @param compactionThreshold Rozmiar dziennika w bajtach, po ktorym w tle powstaje nowa migawka.
+     */
+    explicit JournaledBST(unsigned commitIntervalMs = 10, size_t compactionThreshold = 64 << 20);
+
+    /// @brief Destruktor, utrwala oczekujace zmiany i zatrzymuje watki w tle (close()).
+    ~JournaledBST();
+
+    JournaledBST(const JournaledBST&) = delete;
+    JournaledBST& operator=(const JournaledBST&) = delete;
+
+    /**
+     * @brief Odtwarza drzewo z plikow o podanej sciezce bazowej i uruchamia watki w tle.
+     * * Brak plikow oznacza puste drzewo (pliki zostana utworzone).
+     * @param basePath Sciezka bazowa plikow (np. "drzewo" dla drzewo.bin i drzewo.wal).
+     * @return true jesli odtworzenie sie powiodlo.
+     */
+    bool open(const string& basePath);
+
+    /**
+     * @brief Utrwala oczekujace zmiany, zatrzymuje watki w tle i zamyka dziennik.
+     * @return true jesli wszystkie zmiany zostaly utrwalone.
+     */
+    bool close();
+
+    /**
+     * @brief Dodaje element; rekord trafia do dziennika w najblizszej grupie.
+     * @param data Wartosc do dodania.
+     */
+    void insert(int data);
+
+    /**
+     * @brief Usuwa element; rekord trafia do dziennika w najblizszej grupie.
+     * @param data Wartosc do usuniecia.
+     */
+    void remove(int data);
+
+    /// @brief Usuwa wszystkie elementy.
+    void clear();
+
+    /**
+     * @brief Sprawdza, czy element wystepuje w drzewie.
+     * @param data Szukana wartosc.
+     * @return true jesli element zostal znaleziony.
+     */
+    bool contains(int data) const;
+
+    /**
+     * @brief Zwraca liczbe elementow.
+     * @return Liczba elementow.
+     */
+    size_t getSize() const;
+
+    /**
+     * @brief Czeka, az wszystkie dotychczasowe zmiany zostana utrwalone na dysku.
+     * @return true jesli sie powiodlo, false po bledzie zapisu (lub gdy drzewo nie jest otwarte).
+     */
+    bool sync();
+
+    /**
+     * @brief Zapisuje nowa migawke i zaczyna pusty dziennik (synchronicznie).
+     * * Drzewo jest blokowane tylko na czas skopiowania kluczy; migawka jest zapisywana
+     * bez blokady, wiec zmiany moga trwac rownolegle (trafiaja do nowego dziennika).
+     * @return true jesli migawka zostala zapisana.
+     */
+    bool compact();
+
+    /**
+     * @brief Zwraca aktualny rozmiar dziennika w bajtach.
+     * @return Rozmiar pliku P.wal (z naglowkiem).
+     */
+    unsigned long long getJournalBytes();
+};
@@ -0,0 +1,368 @@
+/**
+ * @file KeyCodec.h
+ * @brief Definicja szablonu KeyCodec - zapisu i odczytu kluczy drzewa w plikach.
+ * * Wersja ogolna korzysta z operatorow strumieniowych (tekst) i surowych bajtow (plik binarny).
+ * Dla kluczy int i long long uporzadkowanych przez less<Key> istnieje specjalizacja
+ * z szybkim, recznym parserem (IntCodec) i kodowaniem roznicowym varint.
+ */
+
+#pragma once
+
+#include <cstring>
+#include <functional>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "IntCodec.h"
+
+using namespace std;
+
+/**
+ * @brief Kodek kluczy dowolnego typu.
+ * * Tekst: kazdy klucz w osobnej linii, zapis operatorem <<, odczyt operatorem >>.
+ * Plik binarny: surowe bajty kolejnych kluczy (w kolejnosci bajtow procesora), co
+ * wymaga typu trywialnie kopiowalnego - np. liczb 64-bitowych bez znaku czy napisow
+ * o stalej dlugosci.
+ * @tparam Key Typ klucza.
+ * @tparam Compare Porzadek kluczy w drzewie (uzywany do sprawdzania odczytanych danych).
+ */
+template <typename Key, typename Compare = less<Key>, typename Enable = void>
+class KeyCodec {
+public:
+    /// @brief Rozmiar klucza zapisywany w naglowku pliku binarnego.
+    static const unsigned char binaryKeySize = sizeof(Key) < 255 ? sizeof(Key) : 255;
+
+    /// @brief Identyfikator kodowania zapisywany w naglowku pliku binarnego (1 = surowe bajty).
+    static const unsigned char binaryEncoding = 1;
+
+    /**
+     * @brief Zapisuje kolejne klucze do strumienia tekstowego.
+     */
+    class TextWriter {
+    private:
+        ostream& out; ///< Strumien docelowy.
+
+    public:
+        /**
+         * @brief Konstruktor.
+         * @param out Strumien docelowy.
+         */
+        explicit TextWriter(ostream& out) : out(out) {}
+
+        /**
+         * @brief Zapisuje jeden klucz.
+         * @param key Klucz.
+         */
+        void put(const Key& key) {
+            out << key << '\n';
+        }
+
+        /// @brief Wysyla zbuforowane dane do strumienia.
+        void flush() {}
+    };
+
+    /**
+     * @brief Parsuje wszystkie klucze z fragmentu tekstu.
+     * @param begin Poczatek tekstu.
+     * @param end Koniec tekstu.
+     * @param out Wektor, do ktorego trafiaja klucze.
+     * @return true jesli caly fragment zostal odczytany, false przy nieprawidlowym tokenie.
+     */
+    static bool parseText(const char* begin, const char* end, vector<Key>& out) {
+        istringstream in(string(begin, end));
+        Key key;
+        while (in >> key) {
+            out.push_back(key);
+        }
+        return in.eof();
+    }
+
+    /**
+     * @brief Czyta wszystkie klucze ze strumienia tekstowego (do pierwszego bledu).
+     * @param in Strumien wejsciowy.
+     * @param out Wektor, do ktorego trafiaja klucze.
+     */
+    static void readText(istream& in, vector<Key>& out) {
+        Key key;
+        while (in >> key) {
+            out.push_back(key);
+        }
+    }
+
+    /**
+     * @brief Zapisuje kolejne klucze binarnie, duzymi blokami.
+     */
+    class BinaryWriter {
+        static_assert(is_trivially_copyable<Key>::value, "Zapis binarny wymaga trywialnie kopiowalnego typu klucza");
+
+    private:
+        ostream& out; ///< Strumien docelowy.
+        vector<char> buffer; ///< Bufor bloku.
+        size_t used; ///< Liczba zajetych bajtow bufora.
+
+    public:
+        /**
+         * @brief Konstruktor.
+         * @param out Strumien docelowy.
+         */
+        explicit BinaryWriter(ostream& out) : out(out), buffer(IntCodec::blockSize), used(0) {}
+
+        /**
+         * @brief Zapisuje jeden klucz.
+         * @param key Klucz.
+         */
+        void put(const Key& key) {
+            if (used + sizeof(Key) > buffer.size()) {
+                flush();
+            }
+            memcpy(buffer.data() + used, &key, sizeof(Key));
+            used += sizeof(Key);
+        }
+
+        /// @brief Wysyla zbuforowane dane do strumienia.
+        void flush() {
+            out.write(buffer.data(), used);
+            used = 0;
+        }
+    };
+
+    /**
+     * @brief Odczytuje klucze zapisane przez BinaryWriter.
+     * @param in Strumien ustawiony na poczatku danych.
+     * @param count Liczba kluczy.
+     * @param comp Porzadek kluczy; klucze musza byc w nim scisle rosnace.
+     * @param out Wektor, do ktorego trafiaja klucze.
+     * @return true jesli odczyt sie powiodl, false jesli dane sa uciete lub nieuporzadkowane.
+     */
+    static bool readBinary(istream& in, unsigned long long count, const Compare& comp, vector<Key>& out) {
+        static_assert(is_trivially_copyable<Key>::value, "Odczyt binarny wymaga trywialnie kopiowalnego typu klucza");
+        const size_t keysPerBlock = IntCodec::blockSize / sizeof(Key) + 1;
+        vector<char> buffer(keysPerBlock * sizeof(Key));
+        while (out.size() < count) {
+            size_t batch = static_cast<size_t>(min<unsigned long long>(keysPerBlock, count - out.size()));
+            in.read(buffer.data(), static_cast<streamsize>(batch * sizeof(Key)));
+            if (static_cast<size_t>(in.gcount()) != batch * sizeof(Key)) {
+                return false; // Plik jest uciety
+            }
+            for (size_t i = 0; i < batch; i++) {
+                Key key;
+                memcpy(&key, buffer.data() + i * sizeof(Key), sizeof(Key));
+                if (!out.empty() && !comp(out.back(), key)) {
+                    return false;
+                }
+                out.push_back(key);
+            }
+        }
+        return true;
+    }
+};
+
+/**
+ * @brief Specjalizacja dla kluczy int i long long w porzadku rosnacym.
+ * * Tekst jest formatowany i parsowany przez IntCodec (bez locale i strumieni), a plik
+ * binarny zawiera pierwsza wartosc jako varint zigzag i kolejne jako varint roznic,
+ * co dla gestych danych daje 1-2 bajty na klucz.
+ */
+template <typename Key>
+class KeyCodec<Key, less<Key>, typename enable_if<is_same<Key, int>::value || is_same<Key, long long>::value>::type> {
+private:
+    typedef typename make_unsigned<Key>::type Unsigned;
+
+    /// @brief Maksymalna dlugosc zapisu varint dla klucza.
+    static const size_t maxVarintBytes = (sizeof(Key) * 8 + 6) / 7;
+
+    /// @brief Koduje liczbe ze znakiem tak, aby male wartosci bezwzgledne mialy male kody.
+    static Unsigned zigzagEncode(Key value) {
+        return (static_cast<Unsigned>(value) << 1) ^ (value < 0 ? ~Unsigned(0) : Unsigned(0));
+    }
+
+    /// @brief Odwrotnosc zigzagEncode.
+    static Key zigzagDecode(Unsigned encoded) {
+        return static_cast<Key>((encoded >> 1) ^ (Unsigned(0) - (encoded & 1u)));
+    }
+
+    /// @brief Zapisuje liczbe jako varint (7 bitow na bajt, najstarszy bit = "ciag dalszy").
+    static char* writeVarint(Unsigned value, char* out) {
+        while (value >= 0x80) {
+            *out++ = static_cast<char>((value & 0x7F) | 0x80);
+            value >>= 7;
+        }
+        *out++ = static_cast<char>(value);
+        return out;
+    }
+
+    /// @brief Odczytuje varint; zwraca nullptr, jesli dane sa uciete lub za dlugie.
+    static const char* readVarint(const char* in, const char* end, Unsigned& value) {
+        value = 0;
+        for (size_t i = 0; i < maxVarintBytes && in != end; i++) {
+            unsigned char byte = static_cast<unsigned char>(*in++);
+            value |= static_cast<Unsigned>(byte & 0x7F) << (7 * i);
+            if ((byte & 0x80) == 0) {
+                return in;
+            }
+        }
+        return nullptr;
+    }
+
+public:
+    /// @brief Rozmiar klucza w naglowku pliku binarnego (0 dla int - jak w plikach sprzed szablonow).
+    static const unsigned char binaryKeySize = is_same<Key, int>::value ? 0 : sizeof(Key);
+
+    /// @brief Identyfikator kodowania w naglowku pliku binarnego (0 = roznice jako varint).
+    static const unsigned char binaryEncoding = 0;
+
+    /**
+     * @brief Zapisuje kolejne klucze do strumienia tekstowego, duzymi blokami.
+     */
+    class TextWriter {
+    private:
+        ostream& out; ///< Strumien docelowy.
+        vector<char> buffer; ///< Bufor bloku.
+        char* position; ///< Miejsce zapisu kolejnej liczby.
+
+    public:
+        /**
+         * @brief Konstruktor.
+         * @param out Strumien docelowy.
+         */
+        explicit TextWriter(ostream& out) : out(out), buffer(IntCodec::blockSize), position(buffer.data()) {}
+
+        /**
+         * @brief Zapisuje jeden klucz.
+         * @param key Klucz.
+         */
+        void put(Key key) {
+            position = IntCodec::format(key, position);
+            *position++ = '\n';
+            if (position >= buffer.data() + buffer.size() - (IntCodec::maxLongChars + 1)) {
+                flush();
+            }
+        }
+
+        /// @brief Wysyla zbuforowane dane do strumienia.
+        void flush() {
+            out.write(buffer.data(), position - buffer.data());
+            position = buffer.data();
+        }
+    };
+
+    /**
+     * @brief Parsuje wszystkie liczby z fragmentu tekstu (IntCodec::parse).
+     * @param begin Poczatek tekstu.
+     * @param end Koniec tekstu.
+     * @param out Wektor, do ktorego trafiaja liczby.
+     * @return true jesli caly fragment zostal odczytany, false przy nieprawidlowym tokenie.
+     */
+    static bool parseText(const char* begin, const char* end, vector<Key>& out) {
+        return IntCodec::parse(begin, end, out);
+    }
+
+    /**
+     * @brief Czyta wszystkie liczby ze strumienia (IntCodec::readAll).
+     * @param in Strumien wejsciowy (najlepiej otwarty w trybie binarnym).
+     * @param out Wektor, do ktorego trafiaja liczby.
+     */
+    static void readText(istream& in, vector<Key>& out) {
+        IntCodec::readAll(in, out);
+    }
+
+    /**
+     * @brief Zapisuje rosnacy ciag kluczy jako varinty roznic, duzymi blokami.
+     */
+    class BinaryWriter {
+    private:
+        ostream& out; ///< Strumien docelowy.
+        vector<char> buffer; ///< Bufor bloku.
+        char* position; ///< Miejsce zapisu kolejnego varinta.
+        bool first; ///< Czy nie zapisano jeszcze zadnej wartosci.
+        Key previous; ///< Ostatnio zapisana wartosc.
+
+    public:
+        /**
+         * @brief Konstruktor.
+         * @param out Strumien docelowy.
+         */
+        explicit BinaryWriter(ostream& out)
+            : out(out), buffer(IntCodec::blockSize), position(buffer.data()), first(true), previous(0) {}
+
+        /**
+         * @brief Zapisuje jeden klucz (wiekszy od poprzedniego).
+         * @param key Klucz.
+         */
+        void put(Key key) {
+            Unsigned encoded = first
+                ? zigzagEncode(key)
+                : static_cast<Unsigned>(key) - static_cast<Unsigned>(previous);
+            position = writeVarint(encoded, position);
+            if (position >= buffer.data() + buffer.size() - maxVarintBytes) {
+                flush();
+            }
+            first = false;
+            previous = key;
+        }
+
+        /// @brief Wysyla zbuforowane dane do strumienia.
+        void flush() {
+            out.write(buffer.data(), position - buffer.data());
+            position = buffer.data();
+        }
+    };
+
+    /**
+     * @brief Odczytuje klucze zapisane przez BinaryWriter.
+     * @param in Strumien ustawiony na poczatku danych.
+     * @param count Liczba kluczy.
+     * @param out Wektor, do ktorego trafiaja klucze.
+     * @return true jesli odczyt sie powiodl (strumien stoi wtedy tuz za ostatnim kluczem),
+     * false jesli dane sa uciete lub uszkodzone.
+     */
+    static bool readBinary(istream& in, unsigned long long count, const less<Key>&, vector<Key>& out) {
+        vector<char> buffer(IntCodec::blockSize);
+        size_t length = 0; // Liczba bajtow w buforze
+        size_t position = 0; // Pozycja odczytu w buforze
+        bool endOfFile = false;
+
+        while (out.size() < count) {
+            // Dbamy, aby w buforze byl caly kolejny varint (lub reszta pliku)
+            if (length - position < maxVarintBytes && !endOfFile) {
+                size_t remaining = length - position;
+                memmove(buffer.data(), buffer.data() + position, remaining);
+                in.read(buffer.data() + remaining, static_cast<streamsize>(buffer.size() - remaining));
+                length = remaining + static_cast<size_t>(in.gcount());
+                position = 0;
+                endOfFile = !in;
+            }
+
+            Unsigned encoded;
+            const char* next = readVarint(buffer.data() + position, buffer.data() + length, encoded);
+            if (next == nullptr) {
+                return false; // Plik jest uciety lub uszkodzony
+            }
+            position = next - buffer.data();
+
+            if (out.empty()) {
+                out.push_back(zigzagDecode(encoded));
+            }
+            else {
+                // Roznica musi byc dodatnia i nie moze wyjsc poza zakres typu klucza
+                Unsigned previous = static_cast<Unsigned>(out.back());
+                if (encoded == 0 || encoded > static_cast<Unsigned>(numeric_limits<Key>::max()) - previous) {
+                    return false;
+                }
+                out.push_back(static_cast<Key>(previous + encoded));
+            }
+        }
+
+        // Cofamy strumien za ostatni klucz - za kluczami moze byc jeszcze sekcja wartosci
+        if (position < length) {
+            in.clear();
+            in.seekg(static_cast<streamoff>(position) - static_cast<streamoff>(length), ios::cur);
+        }
+        return true;
+    }
+};
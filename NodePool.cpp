@@ -0,0 +1,10 @@
+/**
+ * @file NodePool.cpp
+ * @brief Jawna instancjacja puli NodePool dla domyslnego alokatora.
+ */
+
+#include "NodePool.h"
+
+using namespace std;
+
+template class NodePool<>;
@@ -0,0 +1,119 @@
+/**
+ * @file NodePool.h
+ * @brief Definicja klasy NodePool - pulowego alokatora wezlow drzewa.
+ * * Wezly sa wycinane z duzych, ciaglych blokow pamieci (slabow), a zwolnione
+ * wezly trafiaja na liste wolnych blokow i sa uzywane ponownie.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Alokator blokow o stalym rozmiarze, oparty na slabach i liscie wolnych blokow.
+ * * Zamiast wywolywac new/delete dla kazdego wezla, pula przydziela pamiec
+ * duzymi porcjami i wydaje z nich kolejne bloki. Sasiednio wstawiane wezly leza
+ * obok siebie w pamieci, co poprawia lokalnosc odwolan podczas przechodzenia drzewa.
+ * Pula nie wywoluje destruktorow - robi to wlasciciel obiektow przed reset().
+ * @tparam SlabAllocator Alokator bajtow (value_type char), z ktorego pochodza slaby.
+ */
+template <typename SlabAllocator = allocator<char>>
+class NodePool {
+private:
+    /**
+     * @brief Naglowek wolnego bloku - wolne bloki tworza liste jednokierunkowa.
+     */
+    struct FreeBlock {
+        FreeBlock* next; ///< Nastepny wolny blok.
+    };
+
+    /**
+     * @brief Pojedynczy slab (ciagly obszar pamieci na wiele blokow).
+     */
+    struct Slab {
+        char* memory; ///< Poczatek obszaru.
+        size_t capacity; ///< Liczba blokow, ktore miesci slab.
+    };
+
+    SlabAllocator slabAllocator; ///< Zrodlo pamieci slabow.
+    size_t blockSize; ///< Rozmiar pojedynczego bloku (zaokraglony w gore do wyrownania).
+    vector<Slab> slabs; ///< Wszystkie przydzielone slaby (zachowywane po reset()).
+    size_t currentSlab; ///< Indeks slabu, z ktorego wydajemy bloki.
+    size_t used; ///< Liczba blokow wydanych juz z biezacego slabu.
+    FreeBlock* freeList; ///< Lista blokow zwolnionych przez deallocate().
+
+    /// @brief Rozmiar pierwszego slabu (w blokach); kazdy kolejny jest dwa razy wiekszy.
+    static const size_t initialSlabCapacity = 64;
+    /// @brief Gorny limit rozmiaru slabu (w blokach).
+    static const size_t maxSlabCapacity = 65536;
+
+    /**
+     * @brief Przechodzi do nastepnego slabu, w razie potrzeby przydzielajac nowy.
+     */
+    void nextSlab();
+
+public:
+    /**
+     * @brief Konstruktor puli.
+     * @param blockSize Rozmiar pojedynczego obiektu (np. sizeof(Node)).
+     * @param slabAllocator Alokator, z ktorego pochodza slaby.
+     */
+    explicit NodePool(size_t blockSize, const SlabAllocator& slabAllocator = SlabAllocator());
+
+    /// @brief Destruktor, zwraca wszystkie slaby do systemu.
+    ~NodePool();
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    /**
+     * @brief Przydziela jeden blok pamieci.
+     * @return Wskaznik na niezainicjalizowany blok o rozmiarze blockSize.
+     */
+    void* allocate();
+
+    /**
+     * @brief Przydziela ciag kolejnych blokow lezacych jeden za drugim w pamieci.
+     * * Blok i zaczyna sie pod adresem (char*)wynik + i * getBlockSize(). Bloki mozna
+     * zwracac pojedynczo przez deallocate(). Sluzy do budowania poddrzew na innych
+     * watkach - sama pula nie jest bezpieczna dla watkow, ale wydany ciag juz tak.
+     * Ciag, ktory nie miesci sie w biezacym slabie, trafia do nieuzywanego slabu zachowanego
+     * po reset(); jesli zaden nie jest dosc duzy, najwiekszy z nich jest zastepowany nowym.
+     * @param count Liczba blokow (wieksza od zera).
+     * @return Wskaznik na pierwszy blok ciagu.
+     */
+    void* allocateRun(size_t count);
+
+    /**
+     * @brief Zwraca rozmiar bloku po wyrownaniu (odstep miedzy blokami ciagu).
+     * @return Rozmiar bloku w bajtach.
+     */
+    size_t getBlockSize() const;
+
+    /**
+     * @brief Zwraca blok do puli (trafia na liste wolnych blokow).
+     * @param block Blok uzyskany wczesniej z allocate().
+     */
+    void deallocate(void* block);
+
+    /**
+     * @brief Uniewaznia wszystkie wydane bloki w czasie O(1).
+     * * Slaby nie sa zwalniane, tylko zostana ponownie wykorzystane przez kolejne alokacje.
+     */
+    void reset();
+
+    /**
+     * @brief Zwraca liczbe bajtow zarezerwowanych przez pule.
+     * @return Suma rozmiarow wszystkich slabow.
+     */
+    size_t bytesReserved() const;
+};
+
+#include "NodePool.tpp"
+
+// Pula dla domyslnego alokatora jest instancjonowana raz, w NodePool.cpp
+extern template class NodePool<>;
@@ -0,0 +1,130 @@
+/**
+ * @file NodePool.tpp
+ * @brief Implementacja metod szablonu NodePool (dolaczana na koncu NodePool.h).
+ */
+
+#pragma once
+
+#include <new>
+#include <utility> // Do swap
+
+template <typename SlabAllocator>
+NodePool<SlabAllocator>::NodePool(size_t blockSize, const SlabAllocator& slabAllocator)
+    : slabAllocator(slabAllocator), blockSize(blockSize), currentSlab(0), used(0), freeList(nullptr) {
+    // Blok musi pomiescic naglowek listy wolnych blokow i zachowac wyrownanie
+    const size_t alignment = alignof(max_align_t);
+    if (this->blockSize < sizeof(FreeBlock)) {
+        this->blockSize = sizeof(FreeBlock);
+    }
+    this->blockSize = (this->blockSize + alignment - 1) / alignment * alignment;
+}
+
+template <typename SlabAllocator>
+NodePool<SlabAllocator>::~NodePool() {
+    for (size_t i = 0; i < slabs.size(); i++) {
+        allocator_traits<SlabAllocator>::deallocate(slabAllocator, slabs[i].memory, slabs[i].capacity * blockSize);
+    }
+}
+
+template <typename SlabAllocator>
+void NodePool<SlabAllocator>::nextSlab() {
+    if (!slabs.empty()) {
+        currentSlab++;
+    }
+    used = 0;
+    if (currentSlab < slabs.size()) {
+        return; // Slab pozostal po reset() - uzywamy go ponownie
+    }
+
+    size_t capacity = slabs.empty() ? initialSlabCapacity : slabs.back().capacity * 2;
+    if (capacity > maxSlabCapacity) {
+        capacity = maxSlabCapacity;
+    }
+    Slab slab;
+    slab.memory = allocator_traits<SlabAllocator>::allocate(slabAllocator, capacity * blockSize);
+    slab.capacity = capacity;
+    slabs.push_back(slab);
+}
+
+template <typename SlabAllocator>
+void* NodePool<SlabAllocator>::allocate() {
+    if (freeList != nullptr) {
+        FreeBlock* block = freeList;
+        freeList = block->next;
+        return block;
+    }
+    if (slabs.empty() || used == slabs[currentSlab].capacity) {
+        nextSlab();
+    }
+    return slabs[currentSlab].memory + (used++) * blockSize;
+}
+
+template <typename SlabAllocator>
+void* NodePool<SlabAllocator>::allocateRun(size_t count) {
+    if (!slabs.empty() && slabs[currentSlab].capacity - used >= count) {
+        void* run = slabs[currentSlab].memory + used * blockSize;
+        used += count;
+        return run;
+    }
+
+    // Po reset() za biezacym slabem leza nieuzywane slaby z poprzednich budow - jesli ktorys
+    // pomiesci ciag, przestawiamy go tuz za biezacy, zamiast przydzielac nowy (inaczej kazda
+    // przebudowa drzewa zostawialaby w puli kolejny slab wielkosci calego drzewa)
+    size_t position = slabs.empty() ? 0 : currentSlab + 1;
+    size_t largest = slabs.size(); // Najwiekszy nieuzywany slab, za maly na ten ciag
+    for (size_t i = position; i < slabs.size(); i++) {
+        if (slabs[i].capacity >= count) {
+            swap(slabs[position], slabs[i]);
+            currentSlab = position;
+            used = count;
+            return slabs[position].memory;
+        }
+        if (largest == slabs.size() || slabs[i].capacity > slabs[largest].capacity) {
+            largest = i;
+        }
+    }
+
+    // Zaden slab nie pomiesci ciagu - dostaje wlasny slab, wstawiony za biezacym i od razu
+    // oznaczony jako pelny (reszta biezacego slabu czeka do reset()). Najwiekszy nieuzywany
+    // slab zwalniamy: przy przebudowach drzewo rosnie zwykle o kilka wezlow, wiec zostawiony
+    // bylby juz zawsze za maly.
+    if (largest < slabs.size()) {
+        allocator_traits<SlabAllocator>::deallocate(slabAllocator, slabs[largest].memory, slabs[largest].capacity * blockSize);
+        slabs.erase(slabs.begin() + largest);
+    }
+    Slab slab;
+    slab.memory = allocator_traits<SlabAllocator>::allocate(slabAllocator, count * blockSize);
+    slab.capacity = count;
+    slabs.insert(slabs.begin() + position, slab);
+    currentSlab = position;
+    used = count;
+    return slab.memory;
+}
+
+template <typename SlabAllocator>
+void NodePool<SlabAllocator>::deallocate(void* block) {
+    FreeBlock* freed = static_cast<FreeBlock*>(block);
+    freed->next = freeList;
+    freeList = freed;
+}
+
+template <typename SlabAllocator>
+void NodePool<SlabAllocator>::reset() {
+    currentSlab = 0;
+    used = 0;
+    freeList = nullptr;
+}
+
+template <typename SlabAllocator>
+size_t NodePool<SlabAllocator>::getBlockSize() const {
+    return blockSize;
+}
+
+template <typename SlabAllocator>
+size_t NodePool<SlabAllocator>::bytesReserved() const {
+    size_t total = 0;
+    for (size_t i = 0; i < slabs.size(); i++) {
+        total += slabs[i].capacity * blockSize;
+    }
+    return total;
+}
@@ -0,0 +1,16 @@
+/**
+ * @file ParallelTasks.cpp
+ * @brief Implementacja metod klasy ParallelTasks.
+ */
+
+#include "ParallelTasks.h"
+
+using namespace std;
+
+unsigned ParallelTasks::resolveThreads(unsigned requested) {
+    if (requested != 0) {
+        return requested;
+    }
+    unsigned cores = thread::hardware_concurrency();
+    return cores != 0 ? cores : 1;
+}
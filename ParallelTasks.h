@@ -0,0 +1,57 @@
+/**
+ * @file ParallelTasks.h
+ * @brief Definicja klasy ParallelTasks - prostego wykonawcy zadan na wielu watkach.
+ * * Uzywana przy rownoleglym wczytywaniu i budowaniu drzewa: zadania (fragmenty pliku,
+ * fragmenty tablicy, poddrzewa) sa numerowane, a watki pobieraja kolejne numery
+ * ze wspolnego licznika, az zadania sie skoncza.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Zestaw statycznych metod do wykonywania niezaleznych zadan na puli watkow.
+ */
+class ParallelTasks {
+public:
+    /**
+     * @brief Zamienia zadana liczbe watkow na faktycznie uzywana.
+     * @param requested Zadana liczba watkow; 0 oznacza liczbe rdzeni procesora.
+     * @return Liczba watkow (co najmniej 1).
+     */
+    static unsigned resolveThreads(unsigned requested);
+
+    /**
+     * @brief Wykonuje zadania o numerach 0..taskCount-1 i czeka na ich zakonczenie.
+     * * Watek wywolujacy rowniez wykonuje zadania, wiec przy threads == 1 nie jest
+     * tworzony zaden dodatkowy watek.
+     * @param taskCount Liczba zadan.
+     * @param threads Liczba watkow (wlacznie z wywolujacym).
+     * @param task Funkcja wywolywana z numerem zadania (size_t).
+     */
+    template <typename Task>
+    static void run(size_t taskCount, unsigned threads, Task task) {
+        atomic<size_t> next(0);
+        auto worker = [&]() {
+            for (size_t index = next++; index < taskCount; index = next++) {
+                task(index);
+            }
+        };
+
+        size_t helpers = (threads < taskCount ? threads : taskCount);
+        vector<thread> pool;
+        for (size_t i = 1; i < helpers; i++) {
+            pool.emplace_back(worker);
+        }
+        worker();
+        for (size_t i = 0; i < pool.size(); i++) {
+            pool[i].join();
+        }
+    }
+};
@@ -0,0 +1,280 @@
+/**
+ * @file PersistentBST.cpp
+ * @brief Implementacja metod klas PersistentBST i VersionedBST.
+ */
+
+#include "PersistentBST.h"
+#include <algorithm> // Do max
+#include <utility>
+
+using namespace std;
+
+PersistentBST::Node::Node(int data, const Node* left, const Node* right)
+    : data(data), height(1 + max(PersistentBST::height(left), PersistentBST::height(right))),
+    left(left), right(right), references(1) {}
+
+PersistentBST::PersistentBST() : root(nullptr), nodeCount(0) {}
+
+PersistentBST::PersistentBST(const Node* root, size_t nodeCount) : root(root), nodeCount(nodeCount) {}
+
+PersistentBST::~PersistentBST() {
+    release(root);
+}
+
+PersistentBST::PersistentBST(const PersistentBST& other) : root(acquire(other.root)), nodeCount(other.nodeCount) {}
+
+PersistentBST::PersistentBST(PersistentBST&& other) noexcept : root(other.root), nodeCount(other.nodeCount) {
+    other.root = nullptr;
+    other.nodeCount = 0;
+}
+
+PersistentBST& PersistentBST::operator=(const PersistentBST& other) {
+    // Najpierw referencja do nowego korzenia - przypisanie do samego siebie nie zwolni wezlow
+    const Node* oldRoot = root;
+    root = acquire(other.root);
+    nodeCount = other.nodeCount;
+    release(oldRoot);
+    return *this;
+}
+
+PersistentBST& PersistentBST::operator=(PersistentBST&& other) noexcept {
+    if (this != &other) {
+        release(root);
+        root = other.root;
+        nodeCount = other.nodeCount;
+        other.root = nullptr;
+        other.nodeCount = 0;
+    }
+    return *this;
+}
+
+// --- Prywatne metody pomocnicze ---
+
+int PersistentBST::height(const Node* node) {
+    return node ? node->height : 0;
+}
+
+const PersistentBST::Node* PersistentBST::acquire(const Node* node) {
+    if (node != nullptr) {
+        node->references.fetch_add(1, memory_order_relaxed);
+    }
+    return node;
+}
+
+void PersistentBST::release(const Node* node) {
+    // acq_rel: watek zwalniajacy wezel musi widziec wszystkie wczesniejsze odczyty innych watkow
+    if (node != nullptr && node->references.fetch_sub(1, memory_order_acq_rel) == 1) {
+        release(node->left);
+        release(node->right);
+        delete node;
+    }
+}
+
+const PersistentBST::Node* PersistentBST::balance(int data, const Node* left, const Node* right) {
+    int leftHeight = height(left);
+    int rightHeight = height(right);
+
+    // Przy rotacji nowe wezly dostaja referencje do wnukow, a potem oddajemy przejete dziecko -
+    // jesli powstalo w tej operacji, zostanie zwolnione, a wspoldzielone wnuki przetrwaja
+    if (leftHeight > rightHeight + 1) {
+        const Node* result;
+        if (height(left->left) >= height(left->right)) {
+            // Pojedyncza rotacja w prawo
+            result = new Node(left->data, acquire(left->left), new Node(data, acquire(left->right), right));
+        }
+        else {
+            // Podwojna rotacja Lewo-Prawo
+            const Node* pivot = left->right;
+            result = new Node(pivot->data, new Node(left->data, acquire(left->left), acquire(pivot->left)),
+                new Node(data, acquire(pivot->right), right));
+        }
+        release(left);
+        return result;
+    }
+    if (rightHeight > leftHeight + 1) {
+        const Node* result;
+        if (height(right->right) >= height(right->left)) {
+            // Pojedyncza rotacja w lewo
+            result = new Node(right->data, new Node(data, left, acquire(right->left)), acquire(right->right));
+        }
+        else {
+            // Podwojna rotacja Prawo-Lewo
+            const Node* pivot = right->left;
+            result = new Node(pivot->data, new Node(data, left, acquire(pivot->left)),
+                new Node(right->data, acquire(pivot->right), acquire(right->right)));
+        }
+        release(right);
+        return result;
+    }
+    return new Node(data, left, right);
+}
+
+const PersistentBST::Node* PersistentBST::rebuild(const vector<Step>& path, const Node* child) {
+    for (size_t i = path.size(); i > 0; --i) {
+        const Node* node = path[i - 1].node;
+        child = path[i - 1].wentRight
+            ? balance(node->data, acquire(node->left), child)
+            : balance(node->data, child, acquire(node->right));
+    }
+    return child;
+}
+
+const PersistentBST::Node* PersistentBST::buildBalanced(const vector<int>& sorted, size_t begin, size_t end) {
+    if (begin == end) {
+        return nullptr;
+    }
+    size_t middle = begin + (end - begin) / 2;
+    const Node* left = buildBalanced(sorted, begin, middle);
+    const Node* right = buildBalanced(sorted, middle + 1, end);
+    return new Node(sorted[middle], left, right);
+}
+
+// --- Tworzenie nowych wersji ---
+
+PersistentBST PersistentBST::fromSorted(const vector<int>& sorted) {
+    return PersistentBST(buildBalanced(sorted, 0, sorted.size()), sorted.size());
+}
+
+PersistentBST PersistentBST::insert(int data) const {
+    vector<Step> path;
+    const Node* node = root;
+    while (node != nullptr) {
+        if (data == node->data) {
+            return *this; // Brak duplikatow
+        }
+        bool right = data > node->data;
+        path.push_back(Step{ node, right });
+        node = right ? node->right : node->left;
+    }
+    return PersistentBST(rebuild(path, new Node(data, nullptr, nullptr)), nodeCount + 1);
+}
+
+PersistentBST PersistentBST::remove(int data) const {
+    vector<Step> path;
+    const Node* node = root;
+    while (node != nullptr && node->data != data) {
+        bool right = data > node->data;
+        path.push_back(Step{ node, right });
+        node = right ? node->right : node->left;
+    }
+    if (node == nullptr) {
+        return *this; // Brak elementu
+    }
+
+    const Node* replacement;
+    if (node->left != nullptr && node->right != nullptr) {
+        // Dwoje dzieci: nastepnik (najmniejszy w prawym poddrzewie) zajmuje miejsce wezla
+        vector<Step> successorPath;
+        const Node* successor = node->right;
+        while (successor->left != nullptr) {
+            successorPath.push_back(Step{ successor, false });
+            successor = successor->left;
+        }
+        const Node* newRight = rebuild(successorPath, acquire(successor->right));
+        replacement = balance(successor->data, acquire(node->left), newRight);
+    }
+    else {
+        replacement = acquire((node->left != nullptr) ? node->left : node->right);
+    }
+    return PersistentBST(rebuild(path, replacement), nodeCount - 1);
+}
+
+// --- Odczyty ---
+
+bool PersistentBST::contains(int data) const {
+    const Node* node = root;
+    while (node != nullptr) {
+        if (data == node->data) {
+            return true;
+        }
+        node = (data < node->data) ? node->left : node->right;
+    }
+    return false;
+}
+
+vector<int> PersistentBST::findPath(int data) const {
+    vector<int> path;
+    const Node* node = root;
+    while (node != nullptr) {
+        path.push_back(node->data);
+        if (data == node->data) {
+            return path;
+        }
+        node = (data < node->data) ? node->left : node->right;
+    }
+    path.clear();
+    return path;
+}
+
+FrozenBST PersistentBST::freeze() const {
+    vector<int> sorted;
+    sorted.reserve(nodeCount);
+    forEachInorder([&sorted](int data) { sorted.push_back(data); });
+    return FrozenBST(sorted);
+}
+
+size_t PersistentBST::getSize() const {
+    return nodeCount;
+}
+
+int PersistentBST::getHeight() const {
+    return height(root);
+}
+
+// --- VersionedBST ---
+
+VersionedBST::VersionedBST() : versions(1), firstVersion(0) {}
+
+size_t VersionedBST::insert(int data) {
+    lock_guard<mutex> lock(versionsMutex);
+    versions.push_back(versions.back().insert(data));
+    return firstVersion + versions.size() - 1;
+}
+
+size_t VersionedBST::remove(int data) {
+    lock_guard<mutex> lock(versionsMutex);
+    versions.push_back(versions.back().remove(data));
+    return firstVersion + versions.size() - 1;
+}
+
+size_t VersionedBST::commit(const PersistentBST& version) {
+    lock_guard<mutex> lock(versionsMutex);
+    versions.push_back(version);
+    return firstVersion + versions.size() - 1;
+}
+
+PersistentBST VersionedBST::latest() const {
+    lock_guard<mutex> lock(versionsMutex);
+    return versions.back();
+}
+
+bool VersionedBST::snapshot(size_t version, PersistentBST& out) const {
+    PersistentBST found;
+    {
+        lock_guard<mutex> lock(versionsMutex);
+        if (version < firstVersion || version - firstVersion >= versions.size()) {
+            return false;
+        }
+        found = versions[version - firstVersion];
+    }
+    out = move(found); // Poprzednia zawartosc out jest zwalniana juz bez blokady
+    return true;
+}
+
+size_t VersionedBST::getVersion() const {
+    lock_guard<mutex> lock(versionsMutex);
+    return firstVersion + versions.size() - 1;
+}
+
+void VersionedBST::releaseBefore(size_t version) {
+    vector<PersistentBST> released;
+    {
+        lock_guard<mutex> lock(versionsMutex);
+        while (firstVersion < version && versions.size() > 1) {
+            released.push_back(move(versions.front()));
+            versions.pop_front();
+            firstVersion++;
+        }
+    }
+    // Wezly zwalniamy po zdjeciu blokady, aby nie wstrzymywac zapisow i odczytow
+}
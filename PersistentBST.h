@@ -0,0 +1,277 @@
+/**
+ * @file PersistentBST.h
+ * @brief Definicja klas PersistentBST i VersionedBST - trwalego (niezmiennego) drzewa AVL z wersjami.
+ * * insert i remove nie zmieniaja drzewa, tylko zwracaja nowa wersje: kopiowana jest
+ * sciezka od zmienianego miejsca do korzenia, a reszta wezlow jest wspoldzielona ze stara
+ * wersja. Wezly maja atomowe liczniki referencji, wiec wersja zyje tak dlugo, jak jakis
+ * obiekt PersistentBST na nia wskazuje, a jej skopiowanie (migawka) kosztuje O(1).
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include "FrozenBST.h"
+
+using namespace std;
+
+/**
+ * @brief Jedna, niezmienna wersja drzewa AVL (klucze int, bez duplikatow).
+ * * Obiekt jest lekkim uchwytem na korzen: kopiowanie i przypisanie kosztuja O(1)
+ * i nie kopiuja wezlow. Wezly jednej wersji nigdy sie nie zmieniaja, wiec wiele watkow
+ * moze jednoczesnie przeszukiwac i kopiowac ten sam obiekt (jak shared_ptr - przypisanie
+ * do obiektu, ktory jednoczesnie czyta inny watek, wymaga synchronizacji; patrz VersionedBST).
+ */
+class PersistentBST {
+private:
+    /**
+     * @brief Niezmienny wezel drzewa ze wspoldzielonym licznikiem referencji.
+     */
+    struct Node {
+        int data; ///< Wartosc przechowywana w wezle.
+        int height; ///< Wysokosc poddrzewa.
+        const Node* left; ///< Lewe dziecko (wezel posiada jedna referencje).
+        const Node* right; ///< Prawe dziecko (wezel posiada jedna referencje).
+        mutable atomic<size_t> references; ///< Liczba wezlow i uchwytow wskazujacych na wezel.
+
+        /**
+         * @brief Konstruktor wezla; przejmuje po jednej referencji do dzieci.
+         * @param data Wartosc.
+         * @param left Lewe dziecko.
+         * @param right Prawe dziecko.
+         */
+        Node(int data, const Node* left, const Node* right);
+    };
+
+    const Node* root; ///< Korzen wersji (uchwyt posiada jedna referencje).
+    size_t nodeCount; ///< Liczba elementow wersji.
+
+    /**
+     * @brief Konstruktor wersji o podanym korzeniu; przejmuje referencje do korzenia.
+     * @param root Korzen.
+     * @param nodeCount Liczba elementow.
+     */
+    PersistentBST(const Node* root, size_t nodeCount);
+
+    /**
+     * @brief Zwraca wysokosc poddrzewa (0 dla pustego).
+     * @param node Korzen poddrzewa.
+     * @return Wysokosc.
+     */
+    static int height(const Node* node);
+
+    /**
+     * @brief Dodaje referencje do wezla.
+     * @param node Wezel (moze byc nullptr).
+     * @return Ten sam wezel.
+     */
+    static const Node* acquire(const Node* node);
+
+    /**
+     * @brief Zwalnia referencje do wezla; ostatnia zwalnia wezel i jego referencje do dzieci.
+     * * Drzewo jest zrownowazone, wiec glebokosc rekurencji to O(log n).
+     * @param node Wezel (moze byc nullptr).
+     */
+    static void release(const Node* node);
+
+    /**
+     * @brief Tworzy wezel o podanej wartosci i dzieciach, w razie potrzeby wykonujac rotacje AVL.
+     * * Przejmuje po jednej referencji do left i right. Dzieci musza byc zrownowazone,
+     * a ich wysokosci moga sie roznic co najwyzej o 2.
+     * @param data Wartosc.
+     * @param left Lewe poddrzewo.
+     * @param right Prawe poddrzewo.
+     * @return Korzen nowego, zrownowazonego poddrzewa (z jedna referencja dla wywolujacego).
+     */
+    static const Node* balance(int data, const Node* left, const Node* right);
+
+    /**
+     * @brief Element sciezki zapisywanej podczas schodzenia w dol drzewa.
+     */
+    struct Step {
+        const Node* node; ///< Odwiedzony wezel.
+        bool wentRight; ///< Czy dalej zeszlismy do prawego dziecka.
+    };
+
+    /**
+     * @brief Kopiuje sciezke od dolu do korzenia, podpinajac nowe poddrzewo.
+     * * Wezly sciezki pozostaja nietkniete (naleza do starej wersji); ich kopie wspoldziela
+     * z nimi drugie dziecko.
+     * @param path Sciezka od korzenia.
+     * @param child Nowe poddrzewo w miejscu ostatniego kroku (referencja jest przejmowana).
+     * @return Nowy korzen.
+     */
+    static const Node* rebuild(const vector<Step>& path, const Node* child);
+
+    /**
+     * @brief Buduje idealnie zrownowazone poddrzewo z fragmentu posortowanej tablicy.
+     * @param sorted Wartosci posortowane rosnaco.
+     * @param begin Poczatek fragmentu.
+     * @param end Koniec fragmentu (za ostatnim elementem).
+     * @return Korzen poddrzewa.
+     */
+    static const Node* buildBalanced(const vector<int>& sorted, size_t begin, size_t end);
+
+public:
+    /// @brief Konstruktor, tworzy pusta wersje.
+    PersistentBST();
+
+    /// @brief Destruktor, zwalnia referencje do korzenia (wezly innych wersji zostaja).
+    ~PersistentBST();
+
+    /// @brief Konstruktor kopiujacy - migawka w O(1), bez kopiowania wezlow.
+    PersistentBST(const PersistentBST& other);
+
+    /// @brief Konstruktor przenoszacy.
+    PersistentBST(PersistentBST&& other) noexcept;
+
+    /// @brief Operator przypisania - O(1), bez kopiowania wezlow.
+    PersistentBST& operator=(const PersistentBST& other);
+
+    /// @brief Przenoszacy operator przypisania.
+    PersistentBST& operator=(PersistentBST&& other) noexcept;
+
+    /**
+     * @brief Tworzy wersje z posortowanych wartosci (idealnie zrownowazona, w O(n)).
+     * @param sorted Wartosci posortowane rosnaco, bez duplikatow.
+     * @return Nowa wersja.
+     */
+    static PersistentBST fromSorted(const vector<int>& sorted);
+
+    /**
+     * @brief Zwraca nowa wersje z dodanym elementem (O(log n) nowych wezlow).
+     * @param data Wartosc do dodania.
+     * @return Nowa wersja; jesli element juz istnial - ta sama wersja.
+     */
+    PersistentBST insert(int data) const;
+
+    /**
+     * @brief Zwraca nowa wersje bez podanego elementu (O(log n) nowych wezlow).
+     * @param data Wartosc do usuniecia.
+     * @return Nowa wersja; jesli elementu nie bylo - ta sama wersja.
+     */
+    PersistentBST remove(int data) const;
+
+    /**
+     * @brief Sprawdza, czy element wystepuje w tej wersji.
+     * @param data Szukana wartosc.
+     * @return true jesli element zostal znaleziony.
+     */
+    bool contains(int data) const;
+
+    /**
+     * @brief Wyszukuje sciezke od korzenia do elementu.
+     * @param data Wartosc do znalezienia.
+     * @return Wektor wartosci na sciezce; pusty, jesli elementu nie znaleziono.
+     */
+    vector<int> findPath(int data) const;
+
+    /**
+     * @brief Przekazuje wartosci tej wersji rosnaco.
+     * @param visit Funkcja wywolywana dla kazdej wartosci (int).
+     */
+    template <typename Visitor>
+    void forEachInorder(Visitor visit) const {
+        vector<const Node*> stack;
+        const Node* node = root;
+        while (node != nullptr || !stack.empty()) {
+            while (node != nullptr) {
+                stack.push_back(node);
+                node = node->left;
+            }
+            node = stack.back();
+            stack.pop_back();
+            visit(node->data);
+            node = node->right;
+        }
+    }
+
+    /**
+     * @brief Tworzy niezmienna, przyjazna dla pamieci podrecznej kopie tej wersji.
+     * @return Indeks FrozenBST.
+     */
+    FrozenBST freeze() const;
+
+    /**
+     * @brief Zwraca liczbe elementow.
+     * @return Liczba elementow.
+     */
+    size_t getSize() const;
+
+    /**
+     * @brief Zwraca wysokosc drzewa tej wersji.
+     * @return Liczba poziomow (0 dla pustego drzewa).
+     */
+    int getHeight() const;
+};
+
+/**
+ * @brief Historia kolejnych wersji drzewa, numerowanych od 0 (puste drzewo).
+ * * Kazda zmiana tworzy nowa wersje (PersistentBST) i zwraca jej numer. Pobranie dowolnej
+ * zachowanej wersji kosztuje O(1), a zapytania na niej nie zakladaja zadnych blokad, wiec
+ * mozna odpowiadac na pytania o "drzewo w wersji N", podczas gdy zmiany trwaja dalej.
+ * Wszystkie metody sa bezpieczne dla wielu watkow (historie chroni jeden muteks,
+ * trzymany tylko na czas kopiowania sciezki albo uchwytu).
+ */
+class VersionedBST {
+private:
+    mutable mutex versionsMutex; ///< Chroni historie wersji.
+    deque<PersistentBST> versions; ///< Zachowane wersje, od numeru firstVersion.
+    size_t firstVersion; ///< Numer najstarszej zachowanej wersji.
+
+public:
+    /// @brief Konstruktor, tworzy historie z jedna, pusta wersja 0.
+    VersionedBST();
+
+    /**
+     * @brief Dodaje element, tworzac nowa wersje.
+     * @param data Wartosc do dodania.
+     * @return Numer nowej wersji (nowa wersja powstaje rowniez, gdy element juz istnial).
+     */
+    size_t insert(int data);
+
+    /**
+     * @brief Usuwa element, tworzac nowa wersje.
+     * @param data Wartosc do usuniecia.
+     * @return Numer nowej wersji (nowa wersja powstaje rowniez, gdy elementu nie bylo).
+     */
+    size_t remove(int data);
+
+    /**
+     * @brief Dopisuje podana wersje jako najnowsza (np. wczytana z pliku albo wczesniejsza - wycofanie zmian).
+     * @param version Wersja drzewa.
+     * @return Numer nowej wersji.
+     */
+    size_t commit(const PersistentBST& version);
+
+    /**
+     * @brief Zwraca najnowsza wersje (O(1)).
+     * @return Migawka najnowszej wersji.
+     */
+    PersistentBST latest() const;
+
+    /**
+     * @brief Pobiera wersje o podanym numerze (O(1)).
+     * @param version Numer wersji.
+     * @param out Migawka wersji.
+     * @return true jesli wersja istnieje i nie zostala zwolniona przez releaseBefore().
+     */
+    bool snapshot(size_t version, PersistentBST& out) const;
+
+    /**
+     * @brief Zwraca numer najnowszej wersji.
+     * @return Numer wersji.
+     */
+    size_t getVersion() const;
+
+    /**
+     * @brief Zapomina wersje starsze niz podana (najnowsza wersja jest zawsze zachowana).
+     * * Wezly, ktorych nie wspoldziela zadna zachowana wersja ani pobrana migawka, sa zwalniane.
+     * @param version Numer najstarszej wersji, ktora ma pozostac dostepna.
+     */
+    void releaseBefore(size_t version);
+};
@@ -0,0 +1,82 @@
+/**
+ * @file ShardedBST.cpp
+ * @brief Implementacja metod klasy ShardedBST.
+ */
+
+#include "ShardedBST.h"
+#include <algorithm> // Do sort, unique, upper_bound, max
+
+using namespace std;
+
+ShardedBST::ShardedBST(vector<int> splitKeys) : splitKeys(move(splitKeys)) {
+    sort(this->splitKeys.begin(), this->splitKeys.end());
+    this->splitKeys.erase(unique(this->splitKeys.begin(), this->splitKeys.end()), this->splitKeys.end());
+    for (size_t i = 0; i <= this->splitKeys.size(); i++) {
+        shards.push_back(unique_ptr<ConcurrentBST>(new ConcurrentBST()));
+    }
+}
+
+vector<int> ShardedBST::evenSplit(int minKey, int maxKey, size_t shardCount) {
+    vector<int> keys;
+    long long width = static_cast<long long>(maxKey) - minKey + 1;
+    for (size_t i = 1; i < shardCount; i++) {
+        keys.push_back(static_cast<int>(minKey + width * static_cast<long long>(i) / static_cast<long long>(shardCount)));
+    }
+    return keys;
+}
+
+ConcurrentBST& ShardedBST::shardFor(int data) const {
+    size_t index = upper_bound(splitKeys.begin(), splitKeys.end(), data) - splitKeys.begin();
+    return *shards[index];
+}
+
+void ShardedBST::insert(int data) {
+    shardFor(data).insert(data);
+}
+
+void ShardedBST::remove(int data) {
+    shardFor(data).remove(data);
+}
+
+void ShardedBST::clear() {
+    for (size_t i = 0; i < shards.size(); i++) {
+        shards[i]->clear();
+    }
+}
+
+bool ShardedBST::contains(int data) const {
+    return shardFor(data).contains(data);
+}
+
+vector<int> ShardedBST::findPath(int data) const {
+    return shardFor(data).findPath(data);
+}
+
+FrozenBST ShardedBST::freeze() const {
+    // Zakresy sa uporzadkowane, wiec sklejenie ich Inorder daje ciag posortowany
+    vector<int> sorted;
+    for (size_t i = 0; i < shards.size(); i++) {
+        shards[i]->appendInorder(sorted);
+    }
+    return FrozenBST(sorted);
+}
+
+size_t ShardedBST::getSize() const {
+    size_t total = 0;
+    for (size_t i = 0; i < shards.size(); i++) {
+        total += shards[i]->getSize();
+    }
+    return total;
+}
+
+int ShardedBST::getHeight() const {
+    int tallest = 0;
+    for (size_t i = 0; i < shards.size(); i++) {
+        tallest = max(tallest, shards[i]->getHeight());
+    }
+    return tallest;
+}
+
+size_t ShardedBST::getShardCount() const {
+    return shards.size();
+}
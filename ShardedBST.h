@@ -0,0 +1,109 @@
+/**
+ * @file ShardedBST.h
+ * @brief Definicja klasy ShardedBST - drzewa podzielonego na zakresy kluczy dla wielu pisarzy.
+ * * Kazdy zakres kluczy (shard) to osobne drzewo ConcurrentBST z wlasnym muteksem pisarzy
+ * i wlasnym menedzerem epok. Pisarze zmieniajacy rozlaczne zakresy nie rywalizuja
+ * o zadna wspolna blokade, a odczyty pozostaja nieblokujace.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "ConcurrentBST.h"
+#include "FrozenBST.h"
+
+using namespace std;
+
+/**
+ * @brief Zbior drzew ConcurrentBST, z ktorych kazde obsluguje jeden zakres kluczy.
+ * * Zakresy wyznaczaja klucze podzialu: przy kluczach k1 < k2 < ... < kn shard 0
+ * obejmuje wartosci < k1, shard i wartosci z [ki, ki+1), a ostatni wartosci >= kn.
+ */
+class ShardedBST {
+private:
+    vector<int> splitKeys; ///< Posortowane klucze podzialu (o jeden mniej niz shardow).
+    vector<unique_ptr<ConcurrentBST>> shards; ///< Drzewa kolejnych zakresow.
+
+    /**
+     * @brief Zwraca drzewo obslugujace dana wartosc.
+     * @param data Wartosc.
+     * @return Referencja do drzewa zakresu, do ktorego nalezy wartosc.
+     */
+    ConcurrentBST& shardFor(int data) const;
+
+public:
+    /**
+     * @brief Konstruktor, tworzy puste drzewo z podanymi kluczami podzialu.
+     * @param splitKeys Granice zakresow (zostana posortowane, duplikaty sa pomijane).
+     * Pusty wektor oznacza jeden zakres obejmujacy wszystkie wartosci.
+     */
+    explicit ShardedBST(vector<int> splitKeys);
+
+    /**
+     * @brief Tworzy klucze podzialu dzielace przedzial [minKey, maxKey] na rowne zakresy.
+     * @param minKey Najmniejsza spodziewana wartosc.
+     * @param maxKey Najwieksza spodziewana wartosc.
+     * @param shardCount Liczba zakresow (co najmniej 1).
+     * @return Klucze podzialu do przekazania konstruktorowi.
+     */
+    static vector<int> evenSplit(int minKey, int maxKey, size_t shardCount);
+
+    /**
+     * @brief Dodaje element (blokuje tylko pisarzy tego samego zakresu).
+     * @param data Wartosc do dodania.
+     */
+    void insert(int data);
+
+    /**
+     * @brief Usuwa element (blokuje tylko pisarzy tego samego zakresu).
+     * @param data Wartosc do usuniecia.
+     */
+    void remove(int data);
+
+    /**
+     * @brief Usuwa wszystkie elementy ze wszystkich zakresow.
+     */
+    void clear();
+
+    /**
+     * @brief Sprawdza, czy element wystepuje w drzewie (bez blokad).
+     * @param data Szukana wartosc.
+     * @return true jesli element zostal znaleziony.
+     */
+    bool contains(int data) const;
+
+    /**
+     * @brief Wyszukuje sciezke do elementu w drzewie jego zakresu (bez blokad).
+     * @param data Wartosc do znalezienia.
+     * @return Wektor wartosci na sciezce; pusty, jesli elementu nie znaleziono.
+     */
+    vector<int> findPath(int data) const;
+
+    /**
+     * @brief Tworzy niezmienna kopie wszystkich zakresow.
+     * * Kazdy zakres jest spojny sam w sobie; zmiany w roznych zakresach trwajace
+     * podczas wywolania moga byc widoczne czesciowo.
+     * @return Indeks FrozenBST.
+     */
+    FrozenBST freeze() const;
+
+    /**
+     * @brief Zwraca liczbe elementow we wszystkich zakresach.
+     * @return Liczba elementow.
+     */
+    size_t getSize() const;
+
+    /**
+     * @brief Zwraca wysokosc najwyzszego z drzew zakresow.
+     * @return Liczba poziomow (0 dla pustego drzewa).
+     */
+    int getHeight() const;
+
+    /**
+     * @brief Zwraca liczbe zakresow.
+     * @return Liczba shardow.
+     */
+    size_t getShardCount() const;
+};
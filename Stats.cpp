@@ -0,0 +1,135 @@
+/**
+ * @file Stats.cpp
+ * @brief Implementacja migawek statystyk i licznikow z pliku Stats.h.
+ */
+
+#include "Stats.h"
+#include <iomanip>
+#include <sstream>
+
+using namespace std;
+
+TreeStats::TreeStats()
+    : enabled(statsEnabled), nodeCount(0), height(0), bytesUsed(0), bytesReserved(0),
+    lookups(0), comparisons(0), insertions(0), removals(0), rotations(0), rebuilds(0),
+    allocations(0), deallocations(0) {}
+
+double TreeStats::comparisonsPerLookup() const {
+    return lookups == 0 ? 0.0 : static_cast<double>(comparisons) / static_cast<double>(lookups);
+}
+
+string TreeStats::toJson() const {
+    ostringstream out;
+    out << "{\"enabled\":" << (enabled ? "true" : "false")
+        << ",\"nodeCount\":" << nodeCount
+        << ",\"height\":" << height
+        << ",\"bytesUsed\":" << bytesUsed
+        << ",\"bytesReserved\":" << bytesReserved
+        << ",\"lookups\":" << lookups
+        << ",\"comparisons\":" << comparisons
+        << ",\"comparisonsPerLookup\":" << fixed << setprecision(3) << comparisonsPerLookup()
+        << ",\"insertions\":" << insertions
+        << ",\"removals\":" << removals
+        << ",\"rotations\":" << rotations
+        << ",\"rebuilds\":" << rebuilds
+        << ",\"allocations\":" << allocations
+        << ",\"deallocations\":" << deallocations
+        << "}";
+    return out.str();
+}
+
+LatencyHistogram::LatencyHistogram() : count(0), totalMicros(0), maxMicros(0) {
+    for (size_t i = 0; i < bucketCount; i++) {
+        buckets[i] = 0;
+    }
+}
+
+size_t LatencyHistogram::bucketOf(unsigned long long micros) {
+    size_t bucket = 0;
+    while (micros > 1 && bucket < bucketCount - 1) {
+        micros >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+string LatencyHistogram::toJson() const {
+    size_t used = bucketCount;
+    while (used > 0 && buckets[used - 1] == 0) {
+        used--;
+    }
+
+    ostringstream out;
+    out << "{\"count\":" << count
+        << ",\"totalMicros\":" << totalMicros
+        << ",\"maxMicros\":" << maxMicros
+        << ",\"buckets\":[";
+    for (size_t i = 0; i < used; i++) {
+        out << (i > 0 ? "," : "") << buckets[i];
+    }
+    out << "]}";
+    return out.str();
+}
+
+FileStats::FileStats() : enabled(statsEnabled) {}
+
+string FileStats::toJson() const {
+    return string("{\"enabled\":") + (enabled ? "true" : "false")
+        + ",\"textSave\":" + textSave.toJson()
+        + ",\"textLoad\":" + textLoad.toJson()
+        + ",\"binarySave\":" + binarySave.toJson()
+        + ",\"binaryLoad\":" + binaryLoad.toJson()
+        + ",\"snapshotSave\":" + snapshotSave.toJson()
+        + "}";
+}
+
+void TreeCounters<true>::fill(TreeStats& stats) const {
+    stats.enabled = true;
+    stats.lookups = lookups.load(memory_order_relaxed);
+    stats.comparisons = comparisons.load(memory_order_relaxed);
+    stats.insertions = insertions.load(memory_order_relaxed);
+    stats.removals = removals.load(memory_order_relaxed);
+    stats.rotations = rotations.load(memory_order_relaxed);
+    stats.rebuilds = rebuilds.load(memory_order_relaxed);
+    stats.allocations = allocations.load(memory_order_relaxed);
+    stats.deallocations = deallocations.load(memory_order_relaxed);
+}
+
+void TreeCounters<true>::reset() {
+    lookups.store(0, memory_order_relaxed);
+    comparisons.store(0, memory_order_relaxed);
+    insertions.store(0, memory_order_relaxed);
+    removals.store(0, memory_order_relaxed);
+    rotations.store(0, memory_order_relaxed);
+    rebuilds.store(0, memory_order_relaxed);
+    allocations.store(0, memory_order_relaxed);
+    deallocations.store(0, memory_order_relaxed);
+}
+
+void LatencyRecorder<true>::record(unsigned long long micros) {
+    count.fetch_add(1, memory_order_relaxed);
+    totalMicros.fetch_add(micros, memory_order_relaxed);
+    buckets[LatencyHistogram::bucketOf(micros)].fetch_add(1, memory_order_relaxed);
+    unsigned long long previous = maxMicros.load(memory_order_relaxed);
+    while (micros > previous && !maxMicros.compare_exchange_weak(previous, micros, memory_order_relaxed)) {
+        // compare_exchange_weak odswieza previous - probujemy ponownie
+    }
+}
+
+void LatencyRecorder<true>::fill(LatencyHistogram& histogram) const {
+    histogram.count = count.load(memory_order_relaxed);
+    histogram.totalMicros = totalMicros.load(memory_order_relaxed);
+    histogram.maxMicros = maxMicros.load(memory_order_relaxed);
+    for (size_t i = 0; i < LatencyHistogram::bucketCount; i++) {
+        histogram.buckets[i] = buckets[i].load(memory_order_relaxed);
+    }
+}
+
+void LatencyRecorder<true>::reset() {
+    count.store(0, memory_order_relaxed);
+    totalMicros.store(0, memory_order_relaxed);
+    maxMicros.store(0, memory_order_relaxed);
+    for (size_t i = 0; i < LatencyHistogram::bucketCount; i++) {
+        buckets[i].store(0, memory_order_relaxed);
+    }
+}
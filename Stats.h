@@ -0,0 +1,270 @@
+/**
+ * @file Stats.h
+ * @brief Definicje licznikow statystyk drzewa BST i klasy FileHandler.
+ * * Liczniki sa wkompilowywane tylko przy zdefiniowanym BST_STATS=1 (np. /D BST_STATS=1
+ * albo -DBST_STATS=1 dla calego projektu). Bez tego klasy licznikow sa puste, a ich
+ * metody nic nie robia, wiec kompilator usuwa je z goracych sciezek w calosci.
+ * Migawki statystyk (TreeStats, FileStats) sa dostepne zawsze; przy wylaczonych
+ * licznikach zawieraja tylko wartosci wyliczane na zadanie (liczba wezlow, wysokosc, pamiec).
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+using namespace std;
+
+#ifndef BST_STATS
+#define BST_STATS 0
+#endif
+
+/// @brief Czy liczniki statystyk sa wkompilowane (BST_STATS != 0).
+const bool statsEnabled = BST_STATS != 0;
+
+/**
+ * @brief Migawka statystyk drzewa (BasicBST::getStats).
+ */
+struct TreeStats {
+    bool enabled; ///< Czy liczniki byly wkompilowane (inaczej pola licznikow sa zerami).
+    size_t nodeCount; ///< Liczba wezlow.
+    int height; ///< Wysokosc drzewa.
+    size_t bytesUsed; ///< Pamiec zajeta przez wezly (liczba wezlow * rozmiar bloku puli).
+    size_t bytesReserved; ///< Pamiec zarezerwowana przez pule wezlow.
+    unsigned long long lookups; ///< Liczba wyszukiwan (contains, find, findPath, findDepth).
+    unsigned long long comparisons; ///< Liczba porownan kluczy wykonanych przez wyszukiwania.
+    unsigned long long insertions; ///< Liczba wezlow dodanych pojedynczo.
+    unsigned long long removals; ///< Liczba wezlow usunietych pojedynczo.
+    unsigned long long rotations; ///< Liczba rotacji AVL (podwojna rotacja liczy sie jako dwie).
+    unsigned long long rebuilds; ///< Liczba przebudow drzewa od zera (bulkLoad, wsady, wczytanie pliku).
+    unsigned long long allocations; ///< Liczba wezlow utworzonych w pamieci z puli.
+    unsigned long long deallocations; ///< Liczba wezlow zwroconych pojedynczo do puli.
+
+    /// @brief Konstruktor, zeruje wszystkie pola.
+    TreeStats();
+
+    /// @brief Zwraca srednia liczbe porownan na wyszukiwanie (0, jesli nie bylo wyszukiwan).
+    double comparisonsPerLookup() const;
+
+    /// @brief Zwraca statystyki jako obiekt JSON w jednej linii.
+    string toJson() const;
+};
+
+/**
+ * @brief Migawka histogramu czasow operacji.
+ * * Kubelek i zawiera operacje trwajace krocej niz 2^(i+1) mikrosekund (i nie krocej
+ * niz 2^i, poza kubelkiem 0); ostatni kubelek zbiera tez wszystkie dluzsze.
+ */
+struct LatencyHistogram {
+    /// @brief Liczba kubelkow (ostatni obejmuje czasy od okolo 36 minut).
+    static const size_t bucketCount = 32;
+
+    unsigned long long count; ///< Liczba zmierzonych operacji.
+    unsigned long long totalMicros; ///< Suma czasow w mikrosekundach.
+    unsigned long long maxMicros; ///< Najdluzszy czas w mikrosekundach.
+    unsigned long long buckets[bucketCount]; ///< Liczba operacji w kazdym kubelku.
+
+    /// @brief Konstruktor, zeruje histogram.
+    LatencyHistogram();
+
+    /**
+     * @brief Zwraca numer kubelka dla podanego czasu.
+     * @param micros Czas w mikrosekundach.
+     * @return Numer kubelka (od 0 do bucketCount - 1).
+     */
+    static size_t bucketOf(unsigned long long micros);
+
+    /// @brief Zwraca histogram jako obiekt JSON (kubelki do ostatniego niepustego).
+    string toJson() const;
+};
+
+/**
+ * @brief Migawka statystyk operacji plikowych (BasicFileHandler::getStats).
+ */
+struct FileStats {
+    bool enabled; ///< Czy liczniki byly wkompilowane.
+    LatencyHistogram textSave; ///< Czasy saveToText.
+    LatencyHistogram textLoad; ///< Czasy loadFromText.
+    LatencyHistogram binarySave; ///< Czasy saveToBinary.
+    LatencyHistogram binaryLoad; ///< Czasy loadFromBinary.
+    LatencyHistogram snapshotSave; ///< Czasy saveSnapshot.
+
+    /// @brief Konstruktor, tworzy puste histogramy.
+    FileStats();
+
+    /// @brief Zwraca statystyki jako obiekt JSON w jednej linii.
+    string toJson() const;
+};
+
+/**
+ * @brief Liczniki zdarzen drzewa; wersja pusta (BST_STATS=0) nic nie przechowuje.
+ * @tparam Enabled Czy liczniki sa wkompilowane.
+ */
+template <bool Enabled>
+class TreeCounters {
+public:
+    void lookup(size_t) {}
+    void insertion() {}
+    void removal() {}
+    void rotation() {}
+    void rebuild() {}
+    void allocation(size_t) {}
+    void deallocation() {}
+    void fill(TreeStats&) const {}
+    void reset() {}
+};
+
+/**
+ * @brief Liczniki zdarzen drzewa (wersja wkompilowana).
+ * * Wyszukiwania sa metodami const i moga dzialac na wielu watkach naraz (np. pod
+ * wspoldzielona blokada), wiec ich liczniki zwiekszamy atomowo. Pozostale zdarzenia
+ * zachodza tylko w metodach modyfikujacych, ktore wymagaja wylacznego dostepu -
+ * wystarcza im zwykly odczyt i zapis bez instrukcji z blokada magistrali.
+ */
+template <>
+class TreeCounters<true> {
+private:
+    atomic<unsigned long long> lookups;
+    atomic<unsigned long long> comparisons;
+    atomic<unsigned long long> insertions;
+    atomic<unsigned long long> removals;
+    atomic<unsigned long long> rotations;
+    atomic<unsigned long long> rebuilds;
+    atomic<unsigned long long> allocations;
+    atomic<unsigned long long> deallocations;
+
+    /// @brief Zwieksza licznik zmieniany tylko przez jeden watek naraz.
+    static void bump(atomic<unsigned long long>& counter, unsigned long long count) {
+        counter.store(counter.load(memory_order_relaxed) + count, memory_order_relaxed);
+    }
+
+public:
+    TreeCounters() { reset(); }
+
+    /**
+     * @brief Rejestruje jedno wyszukiwanie.
+     * @param steps Liczba odwiedzonych wezlow (porownan kluczy).
+     */
+    void lookup(size_t steps) {
+        lookups.fetch_add(1, memory_order_relaxed);
+        comparisons.fetch_add(steps, memory_order_relaxed);
+    }
+
+    void insertion() { bump(insertions, 1); }
+    void removal() { bump(removals, 1); }
+    void rotation() { bump(rotations, 1); }
+    void rebuild() { bump(rebuilds, 1); }
+    void allocation(size_t count) { bump(allocations, count); }
+    void deallocation() { bump(deallocations, 1); }
+
+    /// @brief Przepisuje wartosci licznikow do migawki.
+    void fill(TreeStats& stats) const;
+
+    /// @brief Zeruje wszystkie liczniki.
+    void reset();
+};
+
+/**
+ * @brief Licznik czasow operacji w postaci histogramu; wersja pusta nic nie mierzy.
+ * @tparam Enabled Czy licznik jest wkompilowany.
+ */
+template <bool Enabled>
+class LatencyRecorder {
+public:
+    void record(unsigned long long) {}
+    void fill(LatencyHistogram&) const {}
+    void reset() {}
+};
+
+/**
+ * @brief Licznik czasow operacji w postaci histogramu (wersja wkompilowana).
+ */
+template <>
+class LatencyRecorder<true> {
+private:
+    atomic<unsigned long long> count;
+    atomic<unsigned long long> totalMicros;
+    atomic<unsigned long long> maxMicros;
+    atomic<unsigned long long> buckets[LatencyHistogram::bucketCount];
+
+public:
+    LatencyRecorder() { reset(); }
+
+    /**
+     * @brief Dodaje jeden pomiar do histogramu.
+     * @param micros Czas operacji w mikrosekundach.
+     */
+    void record(unsigned long long micros);
+
+    /// @brief Przepisuje histogram do migawki.
+    void fill(LatencyHistogram& histogram) const;
+
+    /// @brief Zeruje histogram.
+    void reset();
+};
+
+/**
+ * @brief Mierzy czas od utworzenia do zniszczenia obiektu; wersja pusta nie odczytuje zegara.
+ * @tparam Enabled Czy pomiar jest wkompilowany.
+ */
+template <bool Enabled>
+class ScopedTimer {
+public:
+    explicit ScopedTimer(LatencyRecorder<Enabled>&) {}
+};
+
+/**
+ * @brief Mierzy czas od utworzenia do zniszczenia obiektu i zapisuje go w histogramie.
+ */
+template <>
+class ScopedTimer<true> {
+private:
+    LatencyRecorder<true>& recorder;
+    chrono::steady_clock::time_point start;
+
+public:
+    explicit ScopedTimer(LatencyRecorder<true>& recorder)
+        : recorder(recorder), start(chrono::steady_clock::now()) {}
+
+    ~ScopedTimer() {
+        chrono::steady_clock::duration elapsed = chrono::steady_clock::now() - start;
+        recorder.record(static_cast<unsigned long long>(chrono::duration_cast<chrono::microseconds>(elapsed).count()));
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+};
+
+/**
+ * @brief Histogramy czasow wszystkich operacji plikowych.
+ * @tparam Enabled Czy liczniki sa wkompilowane.
+ */
+template <bool Enabled>
+struct FileCounters {
+    LatencyRecorder<Enabled> textSave;
+    LatencyRecorder<Enabled> textLoad;
+    LatencyRecorder<Enabled> binarySave;
+    LatencyRecorder<Enabled> binaryLoad;
+    LatencyRecorder<Enabled> snapshotSave;
+
+    /// @brief Przepisuje wszystkie histogramy do migawki.
+    void fill(FileStats& stats) const {
+        stats.enabled = Enabled;
+        textSave.fill(stats.textSave);
+        textLoad.fill(stats.textLoad);
+        binarySave.fill(stats.binarySave);
+        binaryLoad.fill(stats.binaryLoad);
+        snapshotSave.fill(stats.snapshotSave);
+    }
+
+    /// @brief Zeruje wszystkie histogramy.
+    void reset() {
+        textSave.reset();
+        textLoad.reset();
+        binarySave.reset();
+        binaryLoad.reset();
+        snapshotSave.reset();
+    }
+};
@@ -0,0 +1,270 @@
+/**
+ * @file TreeSnapshot.cpp
+ * @brief Implementacja metod klasy TreeSnapshot.
+ */
+
+#include "TreeSnapshot.h"
+#include "EytzingerLayout.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <cstring>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace {
+    const char snapshotMagic[4] = { 'B', 'S', 'T', 'S' };
+    const char snapshotVersion = 1;
+
+    /// @brief Zwraca znacznik kolejnosci bajtow biezacej platformy (1 = little-endian, 2 = big-endian).
+    char nativeByteOrder() {
+        const unsigned int probe = 1;
+        return (*reinterpret_cast<const unsigned char*>(&probe) == 1) ? 1 : 2;
+    }
+
+    /// @brief Wypelnia naglowek migawki (bufor o rozmiarze naglowka, wyzerowany).
+    void fillHeader(char* header, unsigned long long total) {
+        memcpy(header, snapshotMagic, sizeof(snapshotMagic));
+        header[4] = snapshotVersion;
+        header[5] = nativeByteOrder();
+        for (int i = 0; i < 8; i++) {
+            header[8 + i] = static_cast<char>((total >> (8 * i)) & 0xFF);
+        }
+    }
+}
+
+TreeSnapshot::TreeSnapshot() : mapped(nullptr), length(0), keys(nullptr), count(0)
+#ifdef _WIN32
+    , fileHandle(nullptr), mappingHandle(nullptr)
+#endif
+{}
+
+TreeSnapshot::~TreeSnapshot() {
+    close();
+}
+
+bool TreeSnapshot::write(const string& filename, const vector<int>& sorted) {
+    ofstream outFile(filename, ios::binary);
+    if (!outFile) {
+        return false;
+    }
+
+    char header[headerSize] = {};
+    fillHeader(header, sorted.size());
+    outFile.write(header, headerSize);
+
+    // Wartosci zapisujemy w natywnej kolejnosci bajtow, aby mozna je bylo czytac wprost z mapowania
+    vector<int> layout(sorted.size() + 1, 0);
+    EytzingerLayout::build(sorted, layout.data());
+    outFile.write(reinterpret_cast<const char*>(layout.data()), layout.size() * sizeof(int));
+
+    outFile.close();
+    return static_cast<bool>(outFile);
+}
+
+bool TreeSnapshot::writeSorted(const string& filename, istream& sorted, unsigned long long count) {
+    ofstream outFile(filename, ios::binary);
+    if (!outFile) {
+        return false;
+    }
+
+    char header[headerSize] = {};
+    fillHeader(header, count);
+    outFile.write(header, headerSize);
+    const int padding = 0;
+    outFile.write(reinterpret_cast<const char*>(&padding), sizeof(int));
+
+    // Przejscie Inorder odwiedza wezly kazdego poziomu od lewej do prawej, a poziom L
+    // zajmuje w tablicy ciagly przedzial od indeksu 2^L - kazdy poziom to wiec osobny
+    // strumien zapisywany sekwencyjnie. Pamiec: bufor wejscia i po jednym buforze na poziom.
+    size_t levels = 0;
+    while (levels < 64 && (1ULL << levels) <= count) {
+        levels++;
+    }
+    vector<vector<int>> buffers(levels);
+    vector<unsigned long long> flushed(levels, 0); // Liczba wartosci poziomu juz zapisanych do pliku
+    for (size_t level = 0; level < levels; level++) {
+        unsigned long long width = min(1ULL << level, count - (1ULL << level) + 1);
+        buffers[level].reserve(static_cast<size_t>(min<unsigned long long>(width, levelBufferSize)));
+    }
+
+    auto flushLevel = [&](size_t level) {
+        vector<int>& buffer = buffers[level];
+        unsigned long long index = (1ULL << level) + flushed[level];
+        outFile.seekp(static_cast<streamoff>(headerSize + index * sizeof(int)));
+        outFile.write(reinterpret_cast<const char*>(buffer.data()), static_cast<streamsize>(buffer.size() * sizeof(int)));
+        flushed[level] += buffer.size();
+        buffer.clear();
+    };
+
+    vector<int> input(inputBufferSize);
+    size_t inputLength = 0;
+    size_t inputPosition = 0;
+    vector<pair<unsigned long long, size_t>> stack; // Wezel i jego poziom; glebokosc O(log n)
+    unsigned long long k = 1;
+    size_t depth = 0;
+    while (k <= count || !stack.empty()) {
+        while (k <= count) {
+            stack.emplace_back(k, depth);
+            k = 2 * k;
+            depth++;
+        }
+        k = stack.back().first;
+        depth = stack.back().second;
+        stack.pop_back();
+
+        if (inputPosition == inputLength) {
+            sorted.read(reinterpret_cast<char*>(input.data()), static_cast<streamsize>(input.size() * sizeof(int)));
+            inputLength = static_cast<size_t>(sorted.gcount()) / sizeof(int);
+            inputPosition = 0;
+            if (inputLength == 0) {
+                return false; // Strumien zawiera mniej niz count wartosci
+            }
+        }
+        buffers[depth].push_back(input[inputPosition++]);
+        if (buffers[depth].size() == buffers[depth].capacity()) {
+            flushLevel(depth);
+        }
+
+        k = 2 * k + 1;
+        depth++;
+    }
+    for (size_t level = 0; level < levels; level++) {
+        if (!buffers[level].empty()) {
+            flushLevel(level);
+        }
+    }
+
+    outFile.close();
+    return static_cast<bool>(outFile);
+}
+
+bool TreeSnapshot::map(const string& filename) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        CloseHandle(file);
+        return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    mappingHandle = mapping;
+    mapped = static_cast<const char*>(view);
+    length = static_cast<size_t>(size.QuadPart);
+#else
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd); // Mapowanie pozostaje wazne po zamknieciu deskryptora
+    if (view == MAP_FAILED) {
+        return false;
+    }
+    mapped = static_cast<const char*>(view);
+    length = static_cast<size_t>(info.st_size);
+#endif
+    return true;
+}
+
+bool TreeSnapshot::open(const string& filename) {
+    close();
+    if (!map(filename)) {
+        cerr << "Blad: Nie mozna zmapowac pliku migawki: " << filename << endl;
+        return false;
+    }
+
+    unsigned long long total = 0;
+    bool valid = length >= headerSize
+        && memcmp(mapped, snapshotMagic, sizeof(snapshotMagic)) == 0
+        && mapped[4] == snapshotVersion
+        && mapped[5] == nativeByteOrder();
+    if (valid) {
+        for (int i = 0; i < 8; i++) {
+            total |= static_cast<unsigned long long>(static_cast<unsigned char>(mapped[8 + i])) << (8 * i);
+        }
+        // Bez dodawania do total - liczba z uszkodzonego naglowka (np. 2^64 - 1) nie moze sie przewinac
+        valid = total < (length - headerSize) / sizeof(int);
+    }
+    if (!valid) {
+        cerr << "Blad: Nieprawidlowy plik migawki: " << filename << endl;
+        close();
+        return false;
+    }
+
+    keys = reinterpret_cast<const int*>(mapped + headerSize);
+    count = static_cast<size_t>(total);
+    return true;
+}
+
+void TreeSnapshot::close() {
+    if (mapped != nullptr) {
+#ifdef _WIN32
+        UnmapViewOfFile(mapped);
+        CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+        mappingHandle = nullptr;
+        fileHandle = nullptr;
+#else
+        munmap(const_cast<char*>(mapped), length);
+#endif
+    }
+    mapped = nullptr;
+    length = 0;
+    keys = nullptr;
+    count = 0;
+}
+
+bool TreeSnapshot::isOpen() const {
+    return mapped != nullptr;
+}
+
+size_t TreeSnapshot::getSize() const {
+    return count;
+}
+
+bool TreeSnapshot::contains(int data) const {
+    return EytzingerLayout::contains(keys, count, data);
+}
+
+vector<int> TreeSnapshot::findPath(int data) const {
+    return EytzingerLayout::findPath(keys, count, data);
+}
+
+void TreeSnapshot::containsBatch(const int* queries, size_t queryCount, bool* found) const {
+    EytzingerLayout::containsBatch(keys, count, queries, queryCount, found);
+}
+
+void TreeSnapshot::lowerBoundBatch(const int* queries, size_t queryCount, int* values, bool* found) const {
+    EytzingerLayout::lowerBoundBatch(keys, count, queries, queryCount, values, found);
+}
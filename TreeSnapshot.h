@@ -0,0 +1,141 @@
+/**
+ * @file TreeSnapshot.h
+ * @brief Definicja klasy TreeSnapshot - migawki drzewa przeszukiwanej bezposrednio w pliku.
+ * * Migawka to plik z wartosciami drzewa w ukladzie Eytzingera. Plik jest mapowany
+ * do pamieci (mmap / MapViewOfFile) i przeszukiwany w miejscu, bez budowania wezlow,
+ * wiec otwarcie nawet bardzo duzej migawki trwa milisekundy.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Tylko-do-odczytu widok migawki drzewa zmapowanej z pliku.
+ * * Format pliku:
+ *   - bajty 0-3: magic "BSTS",
+ *   - bajt 4: wersja formatu (1),
+ *   - bajt 5: kolejnosc bajtow wartosci (1 = little-endian, 2 = big-endian),
+ *   - bajty 8-15: liczba wartosci (uint64, little-endian),
+ *   - od bajtu 64: tablica int32 w ukladzie Eytzingera (z elementem 0 jako wypelnieniem).
+ * Naglowek ma 64 bajty, aby tablica byla wyrownana do linii pamieci podrecznej.
+ */
+class TreeSnapshot {
+private:
+    const char* mapped; ///< Poczatek zmapowanego pliku (nullptr, jesli migawka nie jest otwarta).
+    size_t length; ///< Dlugosc zmapowanego obszaru w bajtach.
+    const int* keys; ///< Tablica wartosci w ukladzie Eytzingera (wewnatrz zmapowanego obszaru).
+    size_t count; ///< Liczba wartosci.
+#ifdef _WIN32
+    void* fileHandle; ///< Uchwyt pliku (HANDLE).
+    void* mappingHandle; ///< Uchwyt mapowania (HANDLE).
+#endif
+
+    /// @brief Rozmiar naglowka pliku w bajtach.
+    static const size_t headerSize = 64;
+
+    /// @brief Maksymalna liczba wartosci buforowanych dla jednego poziomu w writeSorted().
+    static const size_t levelBufferSize = 1 << 14;
+
+    /// @brief Liczba wartosci czytanych naraz ze strumienia w writeSorted().
+    static const size_t inputBufferSize = 1 << 16;
+
+    /**
+     * @brief Mapuje plik do pamieci w trybie tylko do odczytu.
+     * @param filename Nazwa pliku.
+     * @return true jesli mapowanie sie powiodlo.
+     */
+    bool map(const string& filename);
+
+public:
+    /// @brief Konstruktor, tworzy zamknieta (pusta) migawke.
+    TreeSnapshot();
+
+    /// @brief Destruktor, zwalnia mapowanie pliku.
+    ~TreeSnapshot();
+
+    TreeSnapshot(const TreeSnapshot&) = delete;
+    TreeSnapshot& operator=(const TreeSnapshot&) = delete;
+
+    /**
+     * @brief Zapisuje migawke do pliku.
+     * @param filename Nazwa pliku wyjsciowego.
+     * @param sorted Wartosci drzewa posortowane rosnaco, bez duplikatow.
+     * @return true jesli zapis sie powiodl, false w przeciwnym razie.
+     */
+    static bool write(const string& filename, const vector<int>& sorted);
+
+    /**
+     * @brief Zapisuje migawke z posortowanego strumienia, bez wczytywania wartosci do pamieci.
+     * * Wynik jest identyczny jak z write(). Wartosci sa czytane raz, po kolei, a pamiec
+     * jest ograniczona do kilku MiB niezaleznie od ich liczby (patrz ExternalSorter).
+     * @param filename Nazwa pliku wyjsciowego.
+     * @param sorted Strumien binarny z wartosciami int w natywnej kolejnosci bajtow,
+     * posortowanymi rosnaco, bez duplikatow.
+     * @param count Liczba wartosci do odczytania ze strumienia.
+     * @return true jesli zapis sie powiodl, false przy bledzie zapisu lub zbyt krotkim strumieniu.
+     */
+    static bool writeSorted(const string& filename, istream& sorted, unsigned long long count);
+
+    /**
+     * @brief Otwiera (mapuje) migawke z pliku. Poprzednio otwarta migawka jest zamykana.
+     * @param filename Nazwa pliku migawki.
+     * @return true jesli plik zostal zmapowany i ma poprawny naglowek.
+     */
+    bool open(const string& filename);
+
+    /// @brief Zamyka migawke i zwalnia mapowanie.
+    void close();
+
+    /**
+     * @brief Sprawdza, czy migawka jest otwarta.
+     * @return true jesli plik jest zmapowany.
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Zwraca liczbe wartosci w migawce.
+     * @return Liczba wartosci (0 dla zamknietej migawki).
+     */
+    size_t getSize() const;
+
+    /**
+     * @brief Sprawdza, czy wartosc wystepuje w migawce.
+     * @param data Szukana wartosc.
+     * @return true jesli wartosc zostala znaleziona.
+     */
+    bool contains(int data) const;
+
+    /**
+     * @brief Wyszukuje sciezke od korzenia do wartosci w drzewie migawki.
+     * * Sciezka dotyczy zrownowazonego drzewa zapisanego w migawce, a nie
+     * ksztaltu drzewa BST, z ktorego migawka powstala.
+     * @param data Wartosc do znalezienia.
+     * @return Wektor wartosci na sciezce; pusty, jesli elementu nie znaleziono.
+     */
+    vector<int> findPath(int data) const;
+
+    /**
+     * @brief Sprawdza przynaleznosc wielu wartosci naraz, bez alokacji pamieci.
+     * * Zapytania sa przetwarzane grupami schodzacymi po drzewie rownolegle
+     * - patrz EytzingerLayout::containsBatch.
+     * @param queries Szukane wartosci.
+     * @param queryCount Liczba zapytan.
+     * @param found Tablica wynikow (queryCount elementow).
+     */
+    void containsBatch(const int* queries, size_t queryCount, bool* found) const;
+
+    /**
+     * @brief Wyznacza dla wielu zapytan najmniejsza wartosc >= zapytanie, bez alokacji pamieci.
+     * @param queries Szukane wartosci.
+     * @param queryCount Liczba zapytan.
+     * @param values Tablica wynikow: znaleziona wartosc (0, gdy found[i] == false).
+     * @param found Tablica wynikow: czy taka wartosc istnieje.
+     */
+    void lowerBoundBatch(const int* queries, size_t queryCount, int* values, bool* found) const;
+};
@@ -0,0 +1,142 @@
+/**
+ * @file ValueCodec.h
+ * @brief Definicja szablonu ValueCodec - zapisu i odczytu wartosci przechowywanych w wezlach drzewa.
+ * * Wartosci (w przeciwienstwie do kluczy) nie sa uporzadkowane, wiec nie koduje sie ich
+ * roznicowo: w pliku tekstowym stoja za kluczem w tej samej linii, a w pliku binarnym
+ * tworza osobna sekcje za kluczami.
+ */
+
+#pragma once
+
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Pusty typ wartosci - drzewo bez wartosci dziala jak zbior kluczy.
+ */
+struct NoValue {};
+
+/**
+ * @brief Kodek wartosci dowolnego typu.
+ * * Tekst: operatory << i >> (wartosc nie moze wiec zawierac bialych znakow).
+ * Plik binarny: surowe bajty, co wymaga typu trywialnie kopiowalnego.
+ * @tparam Value Typ wartosci.
+ */
+template <typename Value>
+class ValueCodec {
+public:
+    /**
+     * @brief Zapisuje wartosc w pliku tekstowym (za kluczem, oddzielona spacja).
+     * @param out Strumien docelowy.
+     * @param value Wartosc.
+     */
+    static void writeText(ostream& out, const Value& value) {
+        out << ' ' << value;
+    }
+
+    /**
+     * @brief Odczytuje wartosc zapisana przez writeText().
+     * @param in Strumien wejsciowy.
+     * @param value Odczytana wartosc.
+     * @return true jesli odczyt sie powiodl.
+     */
+    static bool readText(istream& in, Value& value) {
+        return static_cast<bool>(in >> value);
+    }
+
+    /**
+     * @brief Zapisuje wartosc binarnie.
+     * @param out Strumien docelowy.
+     * @param value Wartosc.
+     */
+    static void writeBinary(ostream& out, const Value& value) {
+        static_assert(is_trivially_copyable<Value>::value, "Zapis binarny wymaga trywialnie kopiowalnego typu wartosci");
+        out.write(reinterpret_cast<const char*>(&value), sizeof(Value));
+    }
+
+    /**
+     * @brief Odczytuje wartosc zapisana przez writeBinary().
+     * @param in Strumien wejsciowy.
+     * @param value Odczytana wartosc.
+     * @return true jesli odczyt sie powiodl.
+     */
+    static bool readBinary(istream& in, Value& value) {
+        static_assert(is_trivially_copyable<Value>::value, "Odczyt binarny wymaga trywialnie kopiowalnego typu wartosci");
+        in.read(reinterpret_cast<char*>(&value), sizeof(Value));
+        return static_cast<bool>(in);
+    }
+};
+
+/**
+ * @brief Specjalizacja dla napisow: w pliku binarnym dlugosc (varint) i bajty napisu.
+ */
+template <>
+class ValueCodec<string> {
+public:
+    /// @brief Zapisuje napis w pliku tekstowym (za kluczem, oddzielony spacja).
+    static void writeText(ostream& out, const string& value) {
+        out << ' ' << value;
+    }
+
+    /// @brief Odczytuje napis (jeden token) z pliku tekstowego.
+    static bool readText(istream& in, string& value) {
+        return static_cast<bool>(in >> value);
+    }
+
+    /// @brief Zapisuje dlugosc napisu jako varint, a po niej jego bajty.
+    static void writeBinary(ostream& out, const string& value) {
+        size_t length = value.size();
+        while (length >= 0x80) {
+            out.put(static_cast<char>((length & 0x7F) | 0x80));
+            length >>= 7;
+        }
+        out.put(static_cast<char>(length));
+        out.write(value.data(), static_cast<streamsize>(value.size()));
+    }
+
+    /// @brief Odczytuje napis zapisany przez writeBinary().
+    static bool readBinary(istream& in, string& value) {
+        size_t length = 0;
+        for (int shift = 0; ; shift += 7) {
+            int byte = in.get();
+            if (byte == EOF || shift > 56) {
+                return false;
+            }
+            length |= static_cast<size_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                break;
+            }
+        }
+        // Napis czytamy porcjami, aby uszkodzona dlugosc nie wymusila ogromnej alokacji
+        value.clear();
+        char chunk[4096];
+        while (length > 0) {
+            size_t part = length < sizeof(chunk) ? length : sizeof(chunk);
+            in.read(chunk, static_cast<streamsize>(part));
+            if (!in) {
+                return false;
+            }
+            value.append(chunk, part);
+            length -= part;
+        }
+        return true;
+    }
+};
+
+/**
+ * @brief Specjalizacja dla drzewa bez wartosci - nic nie jest zapisywane ani odczytywane.
+ */
+template <>
+class ValueCodec<NoValue> {
+public:
+    static void writeText(ostream&, const NoValue&) {}
+    static bool readText(istream&, NoValue&) { return true; }
+    static void writeBinary(ostream&, const NoValue&) {}
+    static bool readBinary(istream&, NoValue&) { return true; }
+};
@@ -3,14 +3,17 @@
  * @brief Glowny plik programu z interfejsem uzytkownika (menu).
  * * Zawiera funkcje main() oraz funkcje pomocnicze do obslugi
  * konsolowego menu nawigacyjnego dla drzewa BST.
+ * Uruchomiony jako `Drzewo BST --batch [plik]` wykonuje polecenia wsadowo (patrz CommandRunner).
  */
 
+#include <fstream>
 #include <iostream>
 #include <string>
 #include <vector>
 #include <limits> // Do czyszczenia bufora cin
 
 #include "BST.h"
+#include "CommandRunner.h"
 #include "FileHandler.h"
 
 using namespace std; // Dla uproszczenia kodu
@@ -35,6 +38,10 @@ void printMenu() {
         << "3. Wyczysc cale drzewo\n"
         << "4. Szukaj drogi do elementu\n"
         << "5. Wyswietl drzewo (Pre/In/Post/Graficznie)\n"
+        << "10. Pokaz wysokosc drzewa\n"
+        << "11. K-ty najmniejszy element\n"
+        << "12. Pozycja elementu (ile mniejszych)\n"
+        << "13. Liczba elementow w przedziale [a, b]\n"
         << "-----------------------\n"
         << "6. Zapisz drzewo do pliku tekstowego (drzewo.txt)\n"
         << "7. Wczytaj liczby z pliku tekstowego (dane.txt)\n"
@@ -46,11 +53,38 @@ void printMenu() {
         << "Twoj wybor: ";
 }
 
+/**
+ * @brief Wykonuje polecenia w trybie wsadowym (bez menu i pauz).
+ * @param filename Plik z poleceniami (nullptr - standardowe wejscie).
+ * @return 0 jesli wszystkie polecenia sie powiodly, 1 w przeciwnym razie.
+ */
+int runBatch(const char* filename) {
+    ios::sync_with_stdio(false);
+    BST tree;
+    CommandRunner runner(tree, cout);
+
+    if (filename == nullptr) {
+        return runner.run(cin) ? 0 : 1;
+    }
+    ifstream commands(filename, ios::binary);
+    if (!commands.is_open()) {
+        cerr << "Blad: Nie mozna otworzyc pliku z poleceniami: " << filename << endl;
+        return 1;
+    }
+    return runner.run(commands) ? 0 : 1;
+}
+
 /**
  * @brief Glowna funkcja programu, obslugujaca petle zdarzen menu.
+ * @param argc Liczba argumentow.
+ * @param argv Argumenty; `--batch [plik]` wlacza tryb wsadowy.
  * @return 0 po pomyslnym zakonczeniu programu.
  */
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc >= 2 && string(argv[1]) == "--batch") {
+        return runBatch(argc >= 3 ? argv[2] : nullptr);
+    }
+
     BST myTree;
     FileHandler fileHandler;
     int choice;
@@ -120,6 +154,50 @@ int main() {
             myTree.display();
             break;
         }
+        case 10: { // Wysokosc drzewa
+            cout << "Wysokosc drzewa: " << myTree.getHeight()
+                << (myTree.isBalanced() ? " (tryb AVL)" : " (bez rownowazenia)") << "\n";
+            break;
+        }
+        case 11: { // K-ty najmniejszy element
+            size_t k;
+            cout << "Podaj k (od 1 do " << myTree.getSize() << "): ";
+            if (!(cin >> k)) {
+                cout << "Bledna wartosc.\n";
+                clearInputBuffer();
+                break;
+            }
+            const int* found = (k > 0) ? myTree.select(k - 1) : nullptr;
+            if (found == nullptr) {
+                cout << "Drzewo nie ma " << k << "-go elementu.\n";
+            }
+            else {
+                cout << k << "-ty najmniejszy element: " << *found << "\n";
+            }
+            break;
+        }
+        case 12: { // Pozycja elementu
+            int val;
+            cout << "Podaj liczbe: ";
+            if (!(cin >> val)) {
+                cout << "Bledna wartosc.\n";
+                clearInputBuffer();
+                break;
+            }
+            cout << "Liczba elementow mniejszych od " << val << ": " << myTree.rank(val) << "\n";
+            break;
+        }
+        case 13: { // Liczba elementow w przedziale
+            int low, high;
+            cout << "Podaj granice a i b: ";
+            if (!(cin >> low >> high)) {
+                cout << "Bledna wartosc.\n";
+                clearInputBuffer();
+                break;
+            }
+            cout << "Liczba elementow w [" << low << ", " << high << "]: " << myTree.countRange(low, high) << "\n";
+            break;
+        }
         case 6: { // Zapisz do pliku tekstowego
             if (fileHandler.saveToText(myTree, "drzewo.txt")) {
                 cout << "Drzewo zapisane (inorder) do drzewo.txt\n";